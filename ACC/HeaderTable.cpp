@@ -0,0 +1,405 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Prebuilt header tables.
+//
+// A table is built from a header by recording the tokens it produces along
+// with the macro and pragma changes made between them, and the external
+// macros it looked up. If a table is found next to an included header and
+// the files and looked up macros are unchanged, it is played back instead
+// of preprocessing the header.
+//
+// Files are stored relative to the header's directory, so a table can be
+// built before the headers are installed.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACC/HeaderTable.hpp"
+
+#include "ACC/Factory.hpp"
+#include "ACC/IncludeDTBuf.hpp"
+#include "ACC/Macro.hpp"
+#include "ACC/Pragma.hpp"
+#include "ACC/Scope.hpp"
+#include "ACC/TSource.hpp"
+#include "ACC/TStream.hpp"
+
+#include "CC/Parse.hpp"
+
+#include "CPP/IStream.hpp"
+
+#include "Core/Exception.hpp"
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+#include "Core/Path.hpp"
+#include "Core/StringBuf.hpp"
+
+#include "IR/Cache.hpp"
+#include "IR/IArchive.hpp"
+#include "IR/OArchive.hpp"
+#include "IR/Program.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // HeaderFiles
+   //
+   // Maps file names to indexes in a table's files.
+   //
+   using HeaderFiles = std::unordered_map<Core::String, std::size_t>;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::ACC
+{
+   static char const HeaderTableExt[] = ".gdcc-tab";
+
+   static std::unordered_map<Core::String, std::unique_ptr<CPP::HeaderTable>>
+      HeaderTables;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // HeaderGet
+   //
+   static void HeaderGet(IR::IArchive &in, CPP::HeaderTable const &table, Core::Token &out)
+   {
+      Core::Origin pos;
+      unsigned     tok;
+
+      // File index 0 is a name not in the table.
+      if(auto file = IR::GetIR<std::size_t>(in))
+         pos.file = table.files.at(file - 1);
+      else
+         in >> pos.file;
+
+      in >> pos.line >> pos.col >> out.str >> tok;
+      out.pos = pos;
+      out.tok = static_cast<Core::TokenType>(tok);
+   }
+
+   //
+   // HeaderGet
+   //
+   static void HeaderGet(IR::IArchive &in, CPP::HeaderTable const &table,
+      std::vector<Core::Token> &out)
+   {
+      out.resize(IR::GetIR<std::size_t>(in));
+      for(auto &tok : out)
+         HeaderGet(in, table, tok);
+   }
+
+   //
+   // HeaderGet
+   //
+   static void HeaderGet(IR::IArchive &in, CPP::HeaderTable const &table, CPP::Macro &out)
+   {
+      out.func = IR::GetIR<bool>(in);
+      in >> out.args;
+
+      out.list = CPP::Macro::List(IR::GetIR<std::size_t>(in));
+      for(auto &tok : out.list)
+         HeaderGet(in, table, tok);
+   }
+
+   //
+   // HeaderPut
+   //
+   static void HeaderPut(IR::OArchive &out, HeaderFiles const &files,
+      Core::Token const &in)
+   {
+      Core::Origin pos = in.pos;
+
+      auto file = files.find(pos.file);
+      if(file != files.end())
+         out << file->second + 1;
+      else
+         out << std::size_t(0) << pos.file;
+
+      out << pos.line << pos.col << in.str << static_cast<unsigned>(in.tok);
+   }
+
+   //
+   // HeaderPut
+   //
+   static void HeaderPut(IR::OArchive &out, HeaderFiles const &files,
+      std::vector<Core::Token> const &in)
+   {
+      out << in.size();
+      for(auto const &tok : in)
+         HeaderPut(out, files, tok);
+   }
+
+   //
+   // HeaderPut
+   //
+   static void HeaderPut(IR::OArchive &out, HeaderFiles const &files,
+      CPP::Macro const &in)
+   {
+      out << static_cast<bool>(in.func) << in.args;
+
+      out << in.list.size();
+      for(auto const &tok : in.list)
+         HeaderPut(out, files, tok);
+   }
+
+   //
+   // HeaderTableRead
+   //
+   // Reads a table, resolving its files against the header's name. Returns
+   // null if it was built by a different version or its files have changed.
+   //
+   static std::unique_ptr<CPP::HeaderTable> HeaderTableRead(Core::String name,
+      char const *tabName)
+   {
+      auto            buf = Core::FileOpenBlock(tabName);
+      Core::StringBuf sbuf{buf->data(), buf->size()};
+      std::istream    in{&sbuf};
+      IR::IArchive    arc{in};
+
+      if(IR::GetIR<Core::String>(arc) != Core::GetOptions().list.version)
+         return nullptr;
+
+      std::unique_ptr<CPP::HeaderTable> table{new CPP::HeaderTable};
+
+      std::string dir{Core::PathDirname(name).data()};
+      table->files.resize(IR::GetIR<std::size_t>(arc));
+      for(auto &file : table->files)
+      {
+         std::string path = dir;
+         Core::PathAppend(path, IR::GetIR<Core::String>(arc));
+
+         auto hashStr = IR::GetIR<Core::String>(arc);
+
+         IR::CacheHash hash;
+         if(!IR::CacheHashFile(path.data(), hash) || hash.str() != hashStr.data())
+            return nullptr;
+
+         file = {path.data(), path.size()};
+      }
+
+      // The header itself must be the one being included.
+      if(table->files.empty() || table->files[0] != name)
+         return nullptr;
+
+      HeaderGet(arc, *table, table->toks);
+
+      table->events.resize(IR::GetIR<std::size_t>(arc));
+      for(auto &event : table->events)
+      {
+         event.index = IR::GetIR<std::size_t>(arc);
+         event.kind  = static_cast<CPP::HeaderEvent::Kind>(IR::GetIR<unsigned>(arc));
+         arc >> event.name;
+
+         switch(event.kind)
+         {
+         case CPP::HeaderEvent::Kind::Define: HeaderGet(arc, *table, event.macro); break;
+         case CPP::HeaderEvent::Kind::Pragma: HeaderGet(arc, *table, event.toks);  break;
+         case CPP::HeaderEvent::Kind::Undef:                                       break;
+         }
+      }
+
+      table->macroDef.resize(IR::GetIR<std::size_t>(arc));
+      for(auto &macro : table->macroDef)
+      {
+         arc >> macro.first;
+         HeaderGet(arc, *table, macro.second);
+      }
+
+      arc >> table->macroUnd;
+
+      return table;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // HeaderTableClear
+   //
+   void HeaderTableClear()
+   {
+      HeaderTables.clear();
+   }
+
+   //
+   // HeaderTableFind
+   //
+   CPP::HeaderTable const *HeaderTableFind(Core::String name, MacroMap &macros)
+   {
+      auto itr = HeaderTables.find(name);
+
+      if(itr == HeaderTables.end())
+      {
+         std::string tabName{name.data(), name.size()};
+         tabName += HeaderTableExt;
+
+         std::unique_ptr<CPP::HeaderTable> table;
+         if(std::ifstream{tabName})
+            table = HeaderTableRead(name, tabName.data());
+
+         itr = HeaderTables.emplace(name, std::move(table)).first;
+      }
+
+      auto table = itr->second.get();
+      if(!table || !table->check(macros))
+         return nullptr;
+
+      // The header itself has already been added.
+      for(auto file = table->files.begin() + 1, end = table->files.end(); file != end; ++file)
+         Core::FileDepends::Add(file->data(), file->size());
+
+      return table;
+   }
+
+   //
+   // HeaderTableMake
+   //
+   void HeaderTableMake(char const *inName, char const *outName)
+   {
+      CPP::HeaderTable table;
+
+      // Preprocess the header, recording everything it does.
+      {
+         auto buf = Core::FileOpenBlock(inName);
+         Core::FileDepends::Add(inName, std::strlen(inName));
+
+         Core::String      file  {inName};
+         CPP::IncludeLang  langs {"ACS"};
+         MacroMap          macros{CPP::Macro::Stringize(file)};
+         PragmaData        pragd {};
+         PragmaParser      pragp {pragd};
+         CPP::HeaderRecord rec   {file, macros, pragp};
+         Core::StringBuf   sbuf  {buf->data(), buf->size()};
+         CPP::IStream      istr  {sbuf, file};
+         TSource           tsrc  {istr, istr.getOriginSource()};
+         Scope_Global      scope {CC::GetGlobalLabel(buf->getHash())};
+         Factory           fact  {};
+         IR::Program       prog  {};
+         IncStream         tstr  {tsrc, fact, langs, macros, pragd, rec.pragr,
+            Core::PathDirname(file), scope, prog};
+
+         std::size_t imports = ImportDTBuf::Imports;
+
+         for(Core::Token tok; (tok = tstr.get()).tok != Core::TOK_EOF;)
+            rec.put(tok);
+
+         rec.putEnd();
+
+         if(rec.log.special)
+            Core::Error({file, 0}, "cannot tabulate header using __DATE__, "
+               "__FILE__, __LINE__, or __TIME__");
+
+         if(ImportDTBuf::Imports != imports)
+            Core::Error({file, 0}, "cannot tabulate header using #import");
+
+         table = std::move(rec.table);
+      }
+
+      // Store files relative to the header's directory.
+      std::string dir{Core::PathDirname(inName).data()};
+      if(!dir.empty()) Core::PathTerminateEq(dir);
+
+      std::vector<std::string> files;
+      for(auto const &file : table.files)
+         files.emplace_back(file.data(), file.size());
+
+      HeaderFiles fileIdx;
+      for(auto const &file : files)
+      {
+         if(file.compare(0, dir.size(), dir))
+            Core::Error({{file.data(), file.size()}, 0},
+               "cannot tabulate header outside of ", inName, "'s directory");
+
+         fileIdx.emplace(Core::String{file.data(), file.size()}, fileIdx.size());
+      }
+
+      // Strings must exist before the archive is created.
+      Core::String version{Core::GetOptions().list.version};
+
+      std::vector<std::pair<Core::String, Core::String>> fileData;
+      for(auto const &file : files)
+      {
+         IR::CacheHash hash;
+         if(!IR::CacheHashFile(file.data(), hash))
+            Core::ErrorFile(file.data(), "reading");
+
+         fileData.emplace_back(
+            Core::String{file.data() + dir.size(), file.size() - dir.size()},
+            Core::String{hash.str().data()});
+      }
+
+      // Write table.
+      std::ostringstream out;
+      IR::OArchive arc{out};
+      arc.putHead();
+
+      arc << version;
+
+      arc << fileData.size();
+      for(auto const &file : fileData)
+         arc << file.first << file.second;
+
+      HeaderPut(arc, fileIdx, table.toks);
+
+      arc << table.events.size();
+      for(auto const &event : table.events)
+      {
+         arc << event.index << static_cast<unsigned>(event.kind) << event.name;
+
+         switch(event.kind)
+         {
+         case CPP::HeaderEvent::Kind::Define: HeaderPut(arc, fileIdx, event.macro); break;
+         case CPP::HeaderEvent::Kind::Pragma: HeaderPut(arc, fileIdx, event.toks);  break;
+         case CPP::HeaderEvent::Kind::Undef:                                        break;
+         }
+      }
+
+      arc << table.macroDef.size();
+      for(auto const &macro : table.macroDef)
+      {
+         arc << macro.first;
+         HeaderPut(arc, fileIdx, macro.second);
+      }
+
+      arc << table.macroUnd;
+
+      arc.putTail();
+
+      auto outBuf = Core::FileOpenStream(outName, std::ios_base::out | std::ios_base::binary);
+      std::ostream{outBuf.get()} << out.str();
+   }
+}
+
+// EOF
+
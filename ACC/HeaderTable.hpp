@@ -0,0 +1,38 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Prebuilt header tables.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACC__HeaderTable_H__
+#define GDCC__ACC__HeaderTable_H__
+
+#include "../ACC/Types.hpp"
+
+#include "../CPP/HeaderTable.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACC
+{
+   // Forgets the tables read so far, so that changed tables are read again.
+   void HeaderTableClear();
+
+   // Returns the table for the named header, if there is one that is valid
+   // for the current macros.
+   CPP::HeaderTable const *HeaderTableFind(Core::String name, MacroMap &macros);
+
+   // Writes the table for a header included with no prior definitions.
+   void HeaderTableMake(char const *inName, char const *outName);
+}
+
+#endif//GDCC__ACC__HeaderTable_H__
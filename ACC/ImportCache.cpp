@@ -0,0 +1,378 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// #import declaration summary cache.
+//
+// An imported file only contributes declarations, #libdefine macros, and
+// #library names to its importer. So after importing it once, the tokens
+// its declarations parsed from are kept, along with the external macros it
+// looked up. Later imports of the same contents, in the same macro and
+// pragma state, parse those tokens instead of preprocessing the file.
+//
+//-----------------------------------------------------------------------------
+
+#include "ACC/ImportCache.hpp"
+
+#include "ACC/Macro.hpp"
+#include "ACC/Pragma.hpp"
+
+#include "Core/Dir.hpp"
+#include "Core/Option.hpp"
+
+#include "IR/IArchive.hpp"
+#include "IR/OArchive.hpp"
+
+#include "Option/Bool.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // --import-cache
+   //
+   static Option::Bool ImportCacheOpt
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("import-cache")
+         .setGroup("input")
+         .setDescS("Reuses the declarations of previously imported files.")
+         .setDescL("Reuses the declarations of previously imported files. "
+            "A file's declarations are reused if its contents and the macros "
+            "it uses are unchanged. If --cache-dir is set, they are also "
+            "kept there for later compilations.\n"
+            "\n"
+            "Default is on."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::ACC
+{
+   static std::unordered_map<std::string, std::unique_ptr<ImportSummary>>
+      ImportCache;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // ImportGet
+   //
+   static void ImportGet(IR::IArchive &in, Core::Token &out)
+   {
+      Core::Origin pos;
+      unsigned     tok;
+      in >> pos >> out.str >> tok;
+      out.pos = pos;
+      out.tok = static_cast<Core::TokenType>(tok);
+   }
+
+   //
+   // ImportGet
+   //
+   static void ImportGet(IR::IArchive &in, CPP::Macro &out)
+   {
+      bool func;
+      in >> func;
+      out.func = func;
+
+      out.args = CPP::Macro::Args(IR::GetIR<std::size_t>(in));
+      for(auto &arg : out.args)
+         in >> arg;
+
+      out.list = CPP::Macro::List(IR::GetIR<std::size_t>(in));
+      for(auto &tok : out.list)
+         ImportGet(in, tok);
+   }
+
+   //
+   // ImportGet
+   //
+   static void ImportGet(IR::IArchive &in,
+      std::vector<std::pair<Core::String, CPP::Macro>> &out)
+   {
+      out.resize(IR::GetIR<std::size_t>(in));
+      for(auto &macro : out)
+      {
+         in >> macro.first;
+         ImportGet(in, macro.second);
+      }
+   }
+
+   //
+   // ImportGet
+   //
+   static void ImportGet(IR::IArchive &in, ImportSummary &out)
+   {
+      in >> out.prag;
+
+      out.toks.resize(IR::GetIR<std::size_t>(in));
+      for(auto &tok : out.toks)
+         ImportGet(in, tok);
+
+      ImportGet(in, out.macros);
+      in >> out.libs;
+      ImportGet(in, out.macroDef);
+      in >> out.macroUnd;
+   }
+
+   //
+   // ImportPut
+   //
+   static void ImportPut(IR::OArchive &out, Core::Token const &in)
+   {
+      out << in.pos << in.str << static_cast<unsigned>(in.tok);
+   }
+
+   //
+   // ImportPut
+   //
+   static void ImportPut(IR::OArchive &out, CPP::Macro const &in)
+   {
+      out << static_cast<bool>(in.func);
+
+      out << in.args.size();
+      for(auto const &arg : in.args)
+         out << arg;
+
+      out << in.list.size();
+      for(auto const &tok : in.list)
+         ImportPut(out, tok);
+   }
+
+   //
+   // ImportPut
+   //
+   static void ImportPut(IR::OArchive &out,
+      std::vector<std::pair<Core::String, CPP::Macro>> const &in)
+   {
+      out << in.size();
+      for(auto const &macro : in)
+      {
+         out << macro.first;
+         ImportPut(out, macro.second);
+      }
+   }
+
+   //
+   // ImportPut
+   //
+   static void ImportPut(IR::OArchive &out, ImportSummary const &in)
+   {
+      out << in.prag;
+
+      out << in.toks.size();
+      for(auto const &tok : in.toks)
+         ImportPut(out, tok);
+
+      ImportPut(out, in.macros);
+      out << in.libs;
+      ImportPut(out, in.macroDef);
+      out << in.macroUnd;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // ImportRecord::elide
+   //
+   void ImportRecord::elide(std::size_t begin, std::size_t end)
+   {
+      // Only the contents of a complete group can be elided.
+      if(end - begin < 3) return;
+
+      Core::TokenType tt;
+      switch(toks[begin].tok)
+      {
+      case Core::TOK_BraceO: tt = Core::TOK_BraceC; break;
+      case Core::TOK_BrackO: tt = Core::TOK_BrackC; break;
+      case Core::TOK_ParenO: tt = Core::TOK_ParenC; break;
+      default: return;
+      }
+
+      if(toks[end - 1].tok == tt)
+         elided.emplace_back(begin + 1, end - 1);
+   }
+
+   //
+   // ImportRecord::getTokens
+   //
+   std::vector<Core::Token> ImportRecord::getTokens() const
+   {
+      std::vector<bool> keep(toks.size(), true);
+      for(auto const &range : elided)
+         std::fill(keep.begin() + range.first, keep.begin() + range.second, false);
+
+      std::vector<Core::Token> res;
+      res.reserve(std::count(keep.begin(), keep.end(), true));
+
+      for(std::size_t i = 0, e = toks.size(); i != e; ++i)
+         if(keep[i]) res.push_back(toks[i]);
+
+      return res;
+   }
+
+   //
+   // ImportRecord::underflow
+   //
+   void ImportRecord::underflow()
+   {
+      if(tptr() != tend()) return;
+
+      auto pos = tell();
+
+      auto const &tok = src.get();
+      if(tok.tok == Core::TOK_EOF) return;
+
+      toks.push_back(tok);
+      sett(toks.data(), toks.data() + pos, toks.data() + toks.size());
+   }
+
+   //
+   // ImportSummary::check
+   //
+   bool ImportSummary::check(MacroMap &macroMap, PragmaData const &pragd) const
+   {
+      if(prag != GetPrag(pragd))
+         return false;
+
+      for(auto const &name : macroUnd)
+         if(macroMap.find({{}, name, Core::TOK_Identi}))
+            return false;
+
+      for(auto const &macro : macroDef)
+      {
+         auto found = macroMap.find({{}, macro.first, Core::TOK_Identi});
+         if(!found || *found != macro.second)
+            return false;
+      }
+
+      return true;
+   }
+
+   //
+   // ImportSummary::GetPrag
+   //
+   unsigned ImportSummary::GetPrag(PragmaData const &pragd)
+   {
+      return
+         pragd.stateBlockScope     << 0 |
+         pragd.stateDefineRaw      << 1 |
+         pragd.stateFixedType      << 2 |
+         pragd.stateCXLimitedRange << 3 |
+         pragd.stateFEnvAccess     << 4 |
+         pragd.stateFPContract     << 5 |
+         pragd.stateFixedLiteral   << 6 |
+         pragd.stateStrEntLiteral  << 7;
+   }
+
+   //
+   // ImportCacheClear
+   //
+   void ImportCacheClear()
+   {
+      ImportCache.clear();
+   }
+
+   //
+   // ImportCacheEnabled
+   //
+   bool ImportCacheEnabled()
+   {
+      return ImportCacheOpt;
+   }
+
+   //
+   // ImportCacheFind
+   //
+   ImportSummary const *ImportCacheFind(IR::CacheHash const &key,
+      MacroMap &macros, PragmaData const &pragd)
+   {
+      auto keyStr = key.str();
+      auto itr    = ImportCache.find(keyStr);
+
+      if(itr == ImportCache.end())
+      {
+         if(!Core::GetOptions().optCacheDir.data())
+            return nullptr;
+
+         std::ifstream in{IR::CacheGetPath(key, ".imp"),
+            std::ios_base::in | std::ios_base::binary};
+
+         if(!in)
+            return nullptr;
+
+         std::unique_ptr<ImportSummary> sum{new ImportSummary};
+         IR::IArchive arc{in};
+         ImportGet(arc, *sum);
+
+         itr = ImportCache.emplace(keyStr, std::move(sum)).first;
+      }
+
+      return itr->second->check(macros, pragd) ? itr->second.get() : nullptr;
+   }
+
+   //
+   // ImportCacheKey
+   //
+   IR::CacheHash ImportCacheKey(Core::String name, std::string const &data)
+   {
+      IR::CacheHash key = IR::CacheGetArgs();
+      key.add("acc-import").add(name.data()).add(data);
+      return key;
+   }
+
+   //
+   // ImportCachePut
+   //
+   ImportSummary const *ImportCachePut(IR::CacheHash const &key,
+      std::unique_ptr<ImportSummary> &&sum)
+   {
+      if(auto dir = Core::GetOptions().optCacheDir.data())
+      {
+         std::ostringstream out;
+         IR::OArchive arc{out};
+         arc.putHead();
+         ImportPut(arc, *sum);
+         arc.putTail();
+
+         Core::DirCreate(dir);
+         IR::CachePutFile(IR::CacheGetPath(key, ".imp"), out.str());
+      }
+
+      return (ImportCache[key.str()] = std::move(sum)).get();
+   }
+}
+
+// EOF
+
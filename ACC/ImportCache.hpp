@@ -0,0 +1,137 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// #import declaration summary cache.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__ACC__ImportCache_H__
+#define GDCC__ACC__ImportCache_H__
+
+#include "../ACC/Types.hpp"
+
+#include "../CPP/Macro.hpp"
+#include "../CPP/Pragma.hpp"
+
+#include "../Core/TokenBuf.hpp"
+
+#include "../IR/Cache.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::ACC
+{
+   //
+   // ImportPragma
+   //
+   // Forwards to another pragma parser, noting whether any were used.
+   //
+   class ImportPragma : public CPP::PragmaParserBase
+   {
+   public:
+      explicit ImportPragma(CPP::PragmaParserBase &pragp_) :
+         pragp{pragp_}, used{false} {}
+
+      virtual bool parse(Core::Token const *toks, std::size_t n)
+         {used = true; return pragp.parse(toks, n);}
+
+      CPP::PragmaParserBase &pragp;
+
+      bool used;
+   };
+
+   //
+   // ImportRecord
+   //
+   // Keeps every token read from src, so they can be replayed later. Tokens
+   // within skipped balanced groups can be elided.
+   //
+   class ImportRecord : public Core::TokenBuf
+   {
+   public:
+      explicit ImportRecord(Core::TokenBuf &src_) : src(src_) {}
+
+      // Elides the contents of the balanced group read from begin to end.
+      void elide(std::size_t begin, std::size_t end);
+
+      // Returns the recorded tokens, less any elided ones.
+      std::vector<Core::Token> getTokens() const;
+
+      std::size_t tell() const {return tptr() - tbegin();}
+
+   protected:
+      virtual void underflow();
+
+      Core::TokenBuf &src;
+
+      std::vector<Core::Token>                         toks;
+      std::vector<std::pair<std::size_t, std::size_t>> elided;
+   };
+
+   //
+   // ImportSummary
+   //
+   // The result of preprocessing an imported file, sufficient to parse its
+   // declarations again without reading the file.
+   //
+   class ImportSummary
+   {
+   public:
+      // Returns true if the summary is valid for the current state.
+      bool check(MacroMap &macroMap, PragmaData const &pragd) const;
+
+      // Tokens read by the parser, less function bodies and initializers.
+      std::vector<Core::Token> toks;
+
+      // Macros and libraries the file adds to its importer.
+      std::vector<std::pair<Core::String, CPP::Macro>> macros;
+      std::vector<Core::String>                        libs;
+
+      // Macros the file depends on.
+      std::vector<std::pair<Core::String, CPP::Macro>> macroDef;
+      std::vector<Core::String>                        macroUnd;
+
+      // Pragma state when the file was imported.
+      unsigned prag;
+
+
+      static unsigned GetPrag(PragmaData const &pragd);
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::ACC
+{
+   // Discards the summaries in memory.
+   void ImportCacheClear();
+
+   bool ImportCacheEnabled();
+
+   // Returns a summary for the key which is valid for the current state, if
+   // any is in memory or the cache directory.
+   ImportSummary const *ImportCacheFind(IR::CacheHash const &key,
+      MacroMap &macros, PragmaData const &pragd);
+
+   IR::CacheHash ImportCacheKey(Core::String name, std::string const &data);
+
+   ImportSummary const *ImportCachePut(IR::CacheHash const &key,
+      std::unique_ptr<ImportSummary> &&sum);
+}
+
+#endif//GDCC__ACC__ImportCache_H__
@@ -12,6 +12,8 @@
 
 #include "ACC/IncludeDTBuf.hpp"
 
+#include "ACC/HeaderTable.hpp"
+#include "ACC/ImportCache.hpp"
 #include "ACC/Parse.hpp"
 #include "ACC/TSource.hpp"
 #include "ACC/TStream.hpp"
@@ -23,6 +25,20 @@
 
 #include "SR/Statement.hpp"
 
+#include <iterator>
+#include <sstream>
+#include <unordered_set>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::ACC
+{
+   std::size_t ImportDTBuf::Imports = 0;
+}
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -79,6 +95,15 @@ namespace GDCC::ACC
    {
       macros.linePush(CPP::Macro::Stringize(name));
 
+      if(auto table = HeaderTableFind(name, macros))
+      {
+         incBuf.reset();
+         incStr.reset();
+         incSrc.reset();
+         inc.reset(new CPP::HeaderStream(*table, macros, pragp));
+         return;
+      }
+
       incBuf = std::move(newBuf);
       incStr.reset(new CPP::IStream(*incBuf, name));
       incSrc.reset(new TSource(*incStr, incStr->getOriginSource()));
@@ -103,16 +128,58 @@ namespace GDCC::ACC
    }
 
    //
-   // ImportDTBuf::doInc
+   // ImportDTBuf::doImport
    //
-   void ImportDTBuf::doInc(Core::String name,
-      std::unique_ptr<std::streambuf> &&newBuf)
+   // Parses declarations from a cached summary.
+   //
+   void ImportDTBuf::doImport(ImportSummary const &sum)
    {
-      CPP::IStream istr{*newBuf, name};
+      Core::ArrayTBuf   tbuf{sum.toks.data(), sum.toks.size()};
+      Core::TokenStream tstr{&tbuf};
+      Parser            ctx {tstr, fact, pragd, prog, true};
+
+      pragd.push();
+
+      // Read declarations.
+      while(ctx.in.peek().tok != Core::TOK_EOF)
+         ctx.getDecl(scope);
+
+      pragd.drop();
+
+      for(auto const &macro : sum.macros)
+         macros.add(macro.first, macro.second);
+
+      pragd.stateLibrary.insert(pragd.stateLibrary.end(),
+         sum.libs.begin(), sum.libs.end());
+   }
+
+   //
+   // ImportDTBuf::doImport
+   //
+   // Parses declarations from a source file. If sum is not null, it is filled
+   // in and true is returned if it can be used for later imports.
+   //
+   bool ImportDTBuf::doImport(Core::String name, std::streambuf &sbuf,
+      ImportSummary *sum)
+   {
+      CPP::IStream istr{sbuf, name};
       TSource      tsrc{istr, istr.getOriginSource()};
-      ImportStream tstr{tsrc, macros, pragd, pragp};
+      ImportPragma prag{pragp};
+      ImportStream tstr{tsrc, macros, pragd, prag};
+      ImportRecord trec{*tstr.tkbuf()};
       Parser       ctx {tstr, fact, pragd, prog, true};
 
+      std::unique_ptr<CPP::MacroLog> log;
+      auto libC  = pragd.stateLibrary.size();
+      auto pragS = ImportSummary::GetPrag(pragd);
+
+      if(sum)
+      {
+         log.reset(new CPP::MacroLog(macros));
+         tstr.tkbuf(&trec);
+         ctx.importRec = &trec;
+      }
+
       pragd.push();
       macros.tempPush();
 
@@ -122,6 +189,55 @@ namespace GDCC::ACC
 
       macros.tempDrop();
       pragd.drop();
+
+      // Pragmas and macros with changing definitions cannot be replayed.
+      if(!sum || prag.used || log->special)
+         return false;
+
+      sum->toks     = trec.getTokens();
+      sum->libs     = {pragd.stateLibrary.begin() + libC, pragd.stateLibrary.end()};
+      sum->macroDef = std::move(log->defined);
+      sum->macroUnd = std::move(log->undefined);
+      sum->prag     = pragS;
+
+      // Any added macros that remain came from #libdefine.
+      auto added = std::move(log->added);
+      log.reset();
+
+      std::unordered_set<Core::String> addedSet;
+      for(auto const &macroName : added)
+      {
+         if(!addedSet.insert(macroName).second) continue;
+
+         if(auto macro = macros.find({{}, macroName, Core::TOK_Identi}))
+            sum->macros.emplace_back(macroName, *macro);
+      }
+
+      return true;
+   }
+
+   //
+   // ImportDTBuf::doInc
+   //
+   void ImportDTBuf::doInc(Core::String name,
+      std::unique_ptr<std::streambuf> &&newBuf)
+   {
+      ++Imports;
+
+      if(!ImportCacheEnabled())
+         return (void)doImport(name, *newBuf, nullptr);
+
+      std::string data{std::istreambuf_iterator<char>(newBuf.get()), {}};
+      auto        key = ImportCacheKey(name, data);
+
+      if(auto sum = ImportCacheFind(key, macros, pragd))
+         return doImport(*sum);
+
+      std::stringbuf                 sbuf{data, std::ios_base::in};
+      std::unique_ptr<ImportSummary> sum{new ImportSummary};
+
+      if(doImport(name, sbuf, sum.get()))
+         ImportCachePut(key, std::move(sum));
    }
 }
 
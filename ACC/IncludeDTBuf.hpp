@@ -60,6 +60,13 @@ namespace GDCC::ACC
       virtual bool directive(Core::Token const &tok);
 
       virtual void doInc(Core::String name, std::unique_ptr<std::streambuf> &&buf);
+
+      void doImport(ImportSummary const &sum);
+      bool doImport(Core::String name, std::streambuf &sbuf, ImportSummary *sum);
+
+   public:
+      // Count of files imported.
+      static std::size_t Imports;
    };
 }
 
@@ -13,6 +13,7 @@
 #include "ACC/Parse.hpp"
 
 #include "ACC/Factory.hpp"
+#include "ACC/ImportCache.hpp"
 #include "ACC/Pragma.hpp"
 
 #include "Core/Parse.hpp"
@@ -33,6 +34,7 @@ namespace GDCC::ACC
       IR::Program &prog_, bool importing_) :
       CC::Parser{in_, fact_, prag_, prog_},
       prag     {prag_},
+      importRec{nullptr},
       importing{importing_}
    {
    }
@@ -43,6 +45,7 @@ namespace GDCC::ACC
    Parser::Parser(Parser const &ctx, Core::TokenStream &in_) :
       CC::Parser{ctx, in_},
       prag     (ctx.prag),
+      importRec{nullptr},
       importing{ctx.importing}
    {
    }
@@ -70,6 +73,19 @@ namespace GDCC::ACC
    {
    }
 
+   //
+   // Parser::skipBalancedToken
+   //
+   void Parser::skipBalancedToken()
+   {
+      if(!importRec)
+         return CC::Parser::skipBalancedToken();
+
+      auto begin = importRec->tell();
+      CC::Parser::skipBalancedToken();
+      importRec->elide(begin, importRec->tell());
+   }
+
    //
    // ParseEscape
    //
@@ -106,8 +106,13 @@ namespace GDCC::ACC
 
       virtual void parseTypeSpec(CC::Scope &scope, SR::Attribute &attr, CC::TypeSpec &spec);
 
+      virtual void skipBalancedToken();
+
       PragmaData &prag;
 
+      // If set, skipped tokens are elided from the recorded import.
+      ImportRecord *importRec;
+
       bool const importing;
 
    protected:
@@ -53,7 +53,7 @@ namespace GDCC::ACC
          PragmaData &pragd, CPP::PragmaParserBase &pragp) :
          Core::TokenStream{&bbuf},
          tbuf{tsrc},
-         cdir{tbuf, macros},
+         cdir{tbuf, tsrc, macros},
          ddir{cdir, macros, pragd, true},
          ldir{ddir, pragd},
          pdir{ldir, pragp},
@@ -118,7 +118,7 @@ namespace GDCC::ACC
          Core::String dir, Scope_Global &scope, IR::Program &prog) :
          Core::TokenStream{&udir},
          tbuf{tsrc},
-         cdir{tbuf, macros},
+         cdir{tbuf, tsrc, macros},
          ddir{cdir, macros, pragd, false},
          impd{ddir, tsrc, fact, langs, macros, pragd, pragp, dir, scope, prog},
          idir{impd, tsrc, fact, langs, macros, pragd, pragp, dir, scope, prog},
@@ -29,7 +29,10 @@ namespace GDCC::ACC
    class Factory;
    class IgnoreDTBuf;
    class ImportDTBuf;
+   class ImportPragma;
+   class ImportRecord;
    class ImportStream;
+   class ImportSummary;
    class IncStream;
    class IncludeDTBuf;
    class LibraryDTBuf;
@@ -10,17 +10,26 @@
 //
 //-----------------------------------------------------------------------------
 
+#include "ACC/HeaderTable.hpp"
+#include "ACC/ImportCache.hpp"
 #include "ACC/Parse.hpp"
 
+#include "CPP/ConditionDTBuf.hpp"
+#include "CPP/HeaderCache.hpp"
 #include "CPP/IncludeDTBuf.hpp"
 
+#include "Core/Exception.hpp"
 #include "Core/File.hpp"
 #include "Core/Option.hpp"
 
+#include "IR/Cache.hpp"
 #include "IR/Program.hpp"
+#include "IR/Server.hpp"
 
 #include "LD/Linker.hpp"
 
+#include "Option/Bool.hpp"
+
 #include "Target/Info.hpp"
 
 #include <iostream>
@@ -41,27 +50,52 @@ GDCC::Option::CStr ErrorFile
       .setDescS("Write errors to file.")
 };
 
+//
+// --header-table
+//
+GDCC::Option::Bool HeaderTable
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("header-table")
+      .setGroup("output")
+      .setDescS("Writes a header table instead of compiling.")
+      .setDescL("Writes a header table instead of compiling. The table "
+         "records the effect of including the input, and is used in place "
+         "of reading the header when found next to it with the added "
+         "extension .gdcc-tab. If no output is given, that is the default."),
+
+   false
+};
+
 
 //----------------------------------------------------------------------------|
 // Static Functions                                                           |
 //
 
+static void WriteError(char const *filename, char const *what);
+
 //
 // MakeACS
 //
 static void MakeACS()
 {
-   GDCC::IR::Program prog;
+   GDCC::Core::FileDepends deps;
+   GDCC::IR::Program       prog;
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      GDCC::ACC::ParseFile(arg, prog);
+      GDCC::IR::CacheParseFile("acc", arg, prog, GDCC::ACC::ParseFile);
 
    for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
-      GDCC::ACC::ParseFile(arg, prog);
+      GDCC::IR::CacheParseFile("acc", arg, prog, GDCC::ACC::ParseFile);
+
+   if(GDCC::Core::GetOptions().optProgress)
+      GDCC::IR::CachePutStats(std::cerr);
 
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
+
+   GDCC::Core::PutOptionDepends(deps, GDCC::Core::GetOptionOutput());
 }
 
 //
@@ -71,7 +105,8 @@ static void MakeACS()
 //
 static void MakeACSAlt()
 {
-   GDCC::IR::Program prog;
+   GDCC::Core::FileDepends deps;
+   GDCC::IR::Program       prog;
 
    // Determine file extension.
    std::string file{GDCC::Core::GetOptionOutput()};
@@ -85,7 +120,10 @@ static void MakeACSAlt()
    }
 
    // Process input.
-   GDCC::ACC::ParseFile(file.data(), prog);
+   GDCC::IR::CacheParseFile("acc", file.data(), prog, GDCC::ACC::ParseFile);
+
+   if(GDCC::Core::GetOptions().optProgress)
+      GDCC::IR::CachePutStats(std::cerr);
 
    // Replace extension with .o for output.
    file.resize(dot + 2);
@@ -93,6 +131,89 @@ static void MakeACSAlt()
 
    // Write output.
    GDCC::LD::Link(prog, file.data());
+
+   GDCC::Core::PutOptionDepends(deps, file.data());
+}
+
+//
+// MakeHeaderTable
+//
+static void MakeHeaderTable()
+{
+   auto &opts = GDCC::Core::GetOptions();
+
+   if(opts.args.size() > 1)
+      GDCC::Core::Error({}, "--header-table takes one header");
+
+   GDCC::Core::FileDepends deps;
+
+   // With a single argument, it is the input.
+   if(!opts.args.size())
+   {
+      std::string out{GDCC::Core::GetOptionOutput()};
+      out += ".gdcc-tab";
+
+      GDCC::ACC::HeaderTableMake(GDCC::Core::GetOptionOutput(), out.data());
+      GDCC::Core::PutOptionDepends(deps, out.data());
+   }
+   else
+   {
+      GDCC::ACC::HeaderTableMake(opts.args[0], GDCC::Core::GetOptionOutput());
+      GDCC::Core::PutOptionDepends(deps, GDCC::Core::GetOptionOutput());
+   }
+}
+
+//
+// Make
+//
+static void Make()
+{
+   auto &opts = GDCC::Core::GetOptions();
+
+   if(HeaderTable)
+      MakeHeaderTable();
+   else if(!opts.args.size() && !opts.optSysSource.size())
+      MakeACSAlt();
+   else
+      MakeACS();
+}
+
+//
+// MakeServer
+//
+// Handles one compile for --server. Header tables are read again, in case
+// they have been rebuilt since the last compile.
+//
+static void MakeServer()
+{
+   GDCC::ACC::HeaderTableClear();
+
+   try
+   {
+      Make();
+   }
+   catch(std::exception const &e)
+   {
+      WriteError(ErrorFile.data(), e.what());
+      throw;
+   }
+   catch(int e)
+   {
+      if(e == EXIT_FAILURE)
+         WriteError(ErrorFile.data(), "unknown error occurred");
+      throw;
+   }
+}
+
+//
+// ClearServer
+//
+static void ClearServer()
+{
+   GDCC::ACC::HeaderTableClear();
+   GDCC::ACC::ImportCacheClear();
+   GDCC::CPP::ConditionMemoClear();
+   GDCC::CPP::HeaderCacheClear();
 }
 
 //
@@ -135,7 +256,14 @@ int main(int argc, char *argv[])
       "Compiles ACS source into IR data. Output defaults to last loose "
       "argument.";
 
+   opts.optCacheDir.insert(&opts.list);
+   opts.optClient.insert(&opts.list);
+   opts.optDeps.insert(&opts.list);
+   opts.optDepsFile.insert(&opts.list);
+   opts.optDepsPhony.insert(&opts.list);
    opts.optLibPath.insert(&opts.list);
+   opts.optProgress.insert(&opts.list);
+   opts.optServer.insert(&opts.list);
    opts.optSysSource.insert(&opts.list);
 
    // Default target to ZDoom, like acc.
@@ -143,12 +271,17 @@ int main(int argc, char *argv[])
 
    try
    {
-      GDCC::Core::ProcessOptions(opts, argc, argv);
+      GDCC::Core::ProcessOptions(opts, argc, argv, false);
+
+      if(opts.optServer.data())
+         GDCC::IR::ServerRun(MakeServer, ClearServer);
+
+      GDCC::Core::ProcessOptionOutput(opts);
+
+      if(opts.optClient.data())
+         return GDCC::IR::ServerClient();
 
-      if(!opts.args.size() && !opts.optSysSource.size())
-         MakeACSAlt();
-      else
-         MakeACS();
+      Make();
    }
    catch(std::exception const &e)
    {
@@ -14,6 +14,7 @@
 
 #include "Core/Option.hpp"
 
+#include "IR/Cache.hpp"
 #include "IR/Program.hpp"
 
 #include "LD/Linker.hpp"
@@ -34,10 +35,13 @@ static void MakeAsm()
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      GDCC::AS::ParseFile(arg, prog);
+      GDCC::IR::CacheParseFile("as", arg, prog, GDCC::AS::ParseFile);
 
    for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
-      GDCC::AS::ParseFile(arg, prog);
+      GDCC::IR::CacheParseFile("as", arg, prog, GDCC::AS::ParseFile);
+
+   if(GDCC::Core::GetOptions().optProgress)
+      GDCC::IR::CachePutStats(std::cerr);
 
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
@@ -64,7 +68,9 @@ int main(int argc, char *argv[])
       "Compiles assembly into IR data. Output defaults to last loose "
       "argument.";
 
+   opts.optCacheDir.insert(&opts.list);
    opts.optLibPath.insert(&opts.list);
+   opts.optProgress.insert(&opts.list);
    opts.optSysSource.insert(&opts.list);
 
    try
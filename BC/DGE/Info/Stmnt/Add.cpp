@@ -68,8 +68,8 @@ namespace GDCC::BC::DGE
       if(stmnt->args.size() > 3)
       {
          moveArgStk_dst(stmnt->args[0]);
-         moveArgStk_src(stmnt->args[1]);
-         moveArgStk_src(stmnt->args[2]);
+         if(moveArgStk_src(stmnt->args[1])) return;
+         if(moveArgStk_src(stmnt->args[2])) return;
          moveArgStk_src(stmnt->args[3]);
       }
       else
@@ -91,8 +91,8 @@ namespace GDCC::BC::DGE
             IR::ErrorCode(stmnt, "disorder");
 
          moveArgStk_dst(stmnt->args[0]);
-         moveArgStk_src(stmnt->args[1]);
-         moveArgStk_src(stmnt->args[2]);
+         if(moveArgStk_src(stmnt->args[1])) return;
+         if(moveArgStk_src(stmnt->args[2])) return;
          moveArgStk_src(stmnt->args[3]);
       }
       else
@@ -142,12 +142,14 @@ namespace GDCC::BC::DGE
    {
       auto n = getStmntSizeW();
 
-      if(n <= 1)
-         trStmntStk3(false);
+      if(n <= 1 && trStmntStk3(false))
+         return;
 
       if(!isPushArg(stmnt->args[1]) || !isPushArg(stmnt->args[2]))
       {
-         trStmntStk3(false);
+         if(trStmntStk3(false))
+            return;
+
          trStmntTmp(n * 2 - 1);
       }
       else
@@ -161,16 +163,16 @@ namespace GDCC::BC::DGE
    {
       auto n = getStmntSizeW();
 
-      if(n <= 1)
-         trStmntStk2();
+      if(n <= 1 && trStmntStk2())
+         return;
 
       bool stk0, stk1;
 
       if((stk0 = !isDropArg(stmnt->args[0])))
          moveArgStk_dst(stmnt->args[0]);
 
-      if((stk1 = !isPushArg(stmnt->args[1])))
-         moveArgStk_src(stmnt->args[1]);
+      if((stk1 = !isPushArg(stmnt->args[1])) && moveArgStk_src(stmnt->args[1]))
+         return;
 
       if(stk0 && stk1)
          trStmntTmp(n - 1);
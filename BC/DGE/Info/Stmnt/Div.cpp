@@ -121,7 +121,8 @@ namespace GDCC::BC::DGE
    {
       auto n = getStmntSizeW();
 
-      trStmntStk3(true);
+      if(trStmntStk3(true))
+         return;
 
       if(n > 1)
          trStmntTmp(n);
@@ -440,7 +440,15 @@ namespace GDCC::BC::DGE
       switch(val.v)
       {
       case IR::ValueBase::Array:
-         putValueMulti(pos, val.vArray.value);
+         if(!val.vArray.packed.empty())
+         {
+            Core::Array<IR::Value> elems(val.vArray.size());
+            for(std::size_t i = 0, e = elems.size(); i != e; ++i)
+               elems[i] = val.vArray.getElem(i);
+            putValueMulti(pos, elems);
+         }
+         else
+            putValueMulti(pos, val.vArray.value);
          break;
 
       case IR::ValueBase::Assoc:
@@ -0,0 +1,306 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Control flow graph over IR statement blocks.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Flow.hpp"
+
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Function.hpp"
+
+#include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // IsBranch
+   //
+   // Returns true if stmnt must end a basic block.
+   //
+   static bool IsBranch(IR::Statement const *stmnt)
+   {
+      switch(stmnt->code.base)
+      {
+      case IR::CodeBase::Jcnd_Nil:
+      case IR::CodeBase::Jcnd_Tab:
+      case IR::CodeBase::Jcnd_Tru:
+      case IR::CodeBase::Jdyn:
+      case IR::CodeBase::Jfar_Pro:
+      case IR::CodeBase::Jfar_Set:
+      case IR::CodeBase::Jfar_Sta:
+      case IR::CodeBase::Jump:
+      case IR::CodeBase::Retn:
+      case IR::CodeBase::Rjnk:
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // GetLabel
+   //
+   static Core::String GetLabel(IR::Arg const &arg)
+   {
+      if(arg.a != IR::ArgBase::Lit)
+         return nullptr;
+
+      auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*arg.aLit.value);
+      return exp ? static_cast<Core::String>(exp->glyph) : nullptr;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FlowLocalReg
+   //
+   Core::FastU FlowLocalReg(IR::Function const &func, Core::FastU addrEnd)
+   {
+      auto wordBytes = Target::GetWordBytes();
+      auto localReg  = std::max((addrEnd + wordBytes - 1) / wordBytes, func.param);
+
+      // Keep the stack pointer register above everything else.
+      if(FlowStkPtr(func))
+         ++localReg;
+
+      return localReg;
+   }
+
+   //
+   // FlowRemove
+   //
+   void FlowRemove(IR::Block &block, IR::Statement *stmnt)
+   {
+      // The last statement carries any trailing labels, so keep it.
+      if(stmnt->next == &*block.end())
+      {
+         stmnt->code = IR::CodeBase::Nop;
+         stmnt->args = {};
+         return;
+      }
+
+      if(!stmnt->labs.empty())
+         stmnt->next->labs += stmnt->labs;
+
+      delete stmnt;
+   }
+
+   //
+   // FlowStkPtr
+   //
+   bool FlowStkPtr(IR::Function const &func)
+   {
+      return func.allocAut && (func.ctype == IR::CallType::ScriptI ||
+         func.ctype == IR::CallType::ScriptS || func.ctype == IR::CallType::StkCall);
+   }
+
+   //
+   // FlowSet::operator &=
+   //
+   FlowSet &FlowSet::operator &= (FlowSet const &set)
+   {
+      for(std::size_t i = 0, e = bits.size(); i != e; ++i)
+         bits[i] &= set.bits[i];
+      return *this;
+   }
+
+   //
+   // FlowSet::operator |=
+   //
+   FlowSet &FlowSet::operator |= (FlowSet const &set)
+   {
+      for(std::size_t i = 0, e = bits.size(); i != e; ++i)
+         bits[i] |= set.bits[i];
+      return *this;
+   }
+
+   //
+   // FlowSet::any
+   //
+   bool FlowSet::any() const
+   {
+      for(auto const &b : bits)
+         if(b) return true;
+      return false;
+   }
+
+   //
+   // FlowSet::clear
+   //
+   void FlowSet::clear()
+   {
+      for(auto &b : bits)
+         b = 0;
+   }
+
+   //
+   // FlowSet::find
+   //
+   std::size_t FlowSet::find(std::size_t i) const
+   {
+      for(std::size_t w = i / 64, e = bits.size(); w < e; ++w)
+      {
+         std::uint64_t b = bits[w];
+         if(w == i / 64) b &= ~std::uint64_t(0) << i % 64;
+
+         for(std::size_t n = 0; b; ++n, b >>= 1)
+            if(b & 1) return w * 64 + n;
+      }
+
+      return npos;
+   }
+
+   //
+   // FlowSet::sub
+   //
+   FlowSet &FlowSet::sub(FlowSet const &set)
+   {
+      for(std::size_t i = 0, e = bits.size(); i != e; ++i)
+         bits[i] &= ~set.bits[i];
+      return *this;
+   }
+
+   //
+   // FlowGraph constructor
+   //
+   FlowGraph::FlowGraph(IR::Block &block) : valid{true}
+   {
+      std::unordered_map<Core::String, std::size_t> labels;
+      std::size_t                                    index = 0;
+
+      // Split statements into basic blocks.
+      for(auto &stmnt : block)
+      {
+         if(blocks.empty() || !stmnt.labs.empty() || IsBranch(blocks.back().tail))
+            blocks.emplace_back(&stmnt, &stmnt, index);
+         else
+         {
+            blocks.back().tail = &stmnt;
+            ++blocks.back().count;
+         }
+
+         ++index;
+
+         for(auto const &lab : stmnt.labs)
+            labels.emplace(lab, blocks.size() - 1);
+      }
+
+      //
+      // addEdge
+      //
+      auto addEdge = [&](std::size_t from, std::size_t to)
+      {
+         blocks[from].succ.push_back(to);
+         blocks[to].pred.push_back(from);
+      };
+
+      //
+      // addJump
+      //
+      auto addJump = [&](std::size_t from, IR::Arg const &arg)
+      {
+         auto lab = GetLabel(arg);
+         auto itr = lab ? labels.find(lab) : labels.end();
+
+         if(itr == labels.end())
+            return valid = false, void();
+
+         addEdge(from, itr->second);
+      };
+
+      // Link blocks.
+      for(std::size_t i = 0, e = blocks.size(); i != e && valid; ++i)
+      {
+         auto tail = blocks[i].tail;
+         bool fall = i + 1 != e;
+
+         switch(tail->code.base)
+         {
+         case IR::CodeBase::Jcnd_Nil:
+         case IR::CodeBase::Jcnd_Tru:
+            addJump(i, tail->args[1]);
+            break;
+
+         case IR::CodeBase::Jcnd_Tab:
+            for(std::size_t a = 2, n = tail->args.size(); a < n; a += 2)
+               addJump(i, tail->args[a]);
+            break;
+
+         case IR::CodeBase::Jfar_Pro:
+            addJump(i, tail->args[0]);
+            break;
+
+         case IR::CodeBase::Jump:
+            addJump(i, tail->args[0]);
+            fall = false;
+            break;
+
+         case IR::CodeBase::Retn:
+         case IR::CodeBase::Rjnk:
+            fall = false;
+            break;
+
+         // Targets of these cannot be determined statically.
+         case IR::CodeBase::Jdyn:
+         case IR::CodeBase::Jfar_Set:
+         case IR::CodeBase::Jfar_Sta:
+            valid = false;
+            break;
+
+         default:
+            break;
+         }
+
+         if(fall)
+            addEdge(i, i + 1);
+      }
+   }
+
+   //
+   // FlowFunc constructor
+   //
+   FlowFunc::FlowFunc(IR::Function &func_) :
+      func {func_},
+      graph{func_.block}
+   {
+   }
+
+   //
+   // FlowFunc::getRange
+   //
+   std::size_t FlowFunc::getRange(Core::FastU lo, Core::FastU hi)
+   {
+      auto itr = rangeMap.find({lo, hi});
+      if(itr != rangeMap.end())
+         return itr->second;
+
+      ranges.push_back({lo, hi});
+      return rangeMap[{lo, hi}] = ranges.size() - 1;
+   }
+}
+
+// EOF
+
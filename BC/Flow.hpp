@@ -0,0 +1,193 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Control flow graph over IR statement blocks.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__BC__Flow_H__
+#define GDCC__BC__Flow_H__
+
+#include "../BC/Types.hpp"
+
+#include "../Core/Number.hpp"
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FlowSet
+   //
+   // Fixed size bit set for dataflow analysis.
+   //
+   class FlowSet
+   {
+   public:
+      FlowSet() = default;
+      explicit FlowSet(std::size_t size) : bits((size + 63) / 64) {}
+
+      bool operator == (FlowSet const &set) const {return bits == set.bits;}
+      bool operator != (FlowSet const &set) const {return bits != set.bits;}
+
+      FlowSet &operator &= (FlowSet const &set);
+      FlowSet &operator |= (FlowSet const &set);
+
+      bool any() const;
+
+      void clear();
+
+      // Returns the index of the first set bit at or after i, or npos.
+      std::size_t find(std::size_t i = 0) const;
+
+      void reset(std::size_t i) {bits[i / 64] &= ~(std::uint64_t(1) << i % 64);}
+
+      void set(std::size_t i) {bits[i / 64] |= std::uint64_t(1) << i % 64;}
+
+      // Clears every bit that is set in set.
+      FlowSet &sub(FlowSet const &set);
+
+      bool test(std::size_t i) const {return bits[i / 64] >> i % 64 & 1;}
+
+      static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+   private:
+      std::vector<std::uint64_t> bits;
+   };
+
+   //
+   // FlowArg
+   //
+   // A local register operand of a statement.
+   //
+   class FlowArg
+   {
+   public:
+      IR::Arg    *arg;
+      std::size_t range; // Index into FlowFunc::ranges.
+
+      bool def : 1; // Written by the statement.
+      bool use : 1; // Read by the statement.
+      bool lit : 1; // May be replaced by a literal.
+      bool reg : 1; // May be replaced by another local register.
+   };
+
+   //
+   // FlowBlock
+   //
+   // A basic block. Statements in [head, tail] are executed in sequence, and
+   // control can only enter at head and leave after tail.
+   //
+   class FlowBlock
+   {
+   public:
+      FlowBlock(IR::Statement *head_, IR::Statement *tail_, std::size_t first_) :
+         head{head_}, tail{tail_}, first{first_}, count{1} {}
+
+      IR::Statement *head;
+      IR::Statement *tail;
+
+      // Index and count of the block's statements in the function.
+      std::size_t first;
+      std::size_t count;
+
+      std::vector<std::size_t> pred;
+      std::vector<std::size_t> succ;
+   };
+
+   //
+   // FlowRange
+   //
+   // A range of local register addresses, [lo, hi).
+   //
+   class FlowRange
+   {
+   public:
+      bool contains(FlowRange const &r) const {return lo <= r.lo && r.hi <= hi;}
+
+      bool overlaps(FlowRange const &r) const {return lo < r.hi && r.lo < hi;}
+
+      Core::FastU lo, hi;
+   };
+
+   //
+   // FlowStmnt
+   //
+   class FlowStmnt
+   {
+   public:
+      explicit FlowStmnt(IR::Statement *stmnt_) : stmnt{stmnt_} {}
+
+      IR::Statement       *stmnt;
+      std::vector<FlowArg> args;
+   };
+
+   //
+   // FlowGraph
+   //
+   class FlowGraph
+   {
+   public:
+      explicit FlowGraph(IR::Block &block);
+
+      // False if the graph could not be built, such as for dynamic jumps.
+      explicit operator bool () const {return valid;}
+
+      std::vector<FlowBlock> blocks;
+
+      bool valid;
+   };
+
+   //
+   // FlowFunc
+   //
+   // Control flow graph and local register operands of a function.
+   //
+   class FlowFunc
+   {
+   public:
+      explicit FlowFunc(IR::Function &func);
+
+      std::size_t getRange(Core::FastU lo, Core::FastU hi);
+
+      IR::Function          &func;
+      FlowGraph              graph;
+      std::vector<FlowRange> ranges;
+      std::vector<FlowStmnt> stmnts;
+
+   private:
+      std::map<std::pair<Core::FastU, Core::FastU>, std::size_t> rangeMap;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   // Returns the register count needed for addresses below addrEnd.
+   Core::FastU FlowLocalReg(IR::Function const &func, Core::FastU addrEnd);
+
+   // Returns true if func keeps its stack pointer in its last register.
+   bool FlowStkPtr(IR::Function const &func);
+
+   // Removes stmnt from block, moving its labels to the next statement.
+   void FlowRemove(IR::Block &block, IR::Statement *stmnt);
+}
+
+#endif//GDCC__BC__Flow_H__
+
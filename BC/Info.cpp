@@ -76,12 +76,8 @@
               stmnt = static_cast<IR::Statement *>(block->begin()); \
          while(stmnt != end) \
          { \
-            try \
-            { \
-               set##Stmnt(); \
-               stmnt = stmnt->next; \
-            } \
-            catch(ResetStmnt const &) {} \
+            set##Stmnt(); \
+            stmnt = stmnt->next; \
          } \
          stmnt = nullptr; \
       } \
@@ -149,11 +145,15 @@ namespace GDCC::BC
    DefaultFuncSet(put)
    DefaultFuncSet(tr)
 
-   DeferFunc(Program, chk, prog)
-   DeferFunc(Program, gen, prog)
-   DeferFunc(Program, opt, prog)
-   DeferFunc(Program, pre, prog)
-   DeferFunc(Program, tr,  prog)
+   DeferFunc(Program, chk,  prog)
+   DeferFunc(Program, flow, prog)
+   DeferFunc(Program, gen,  prog)
+   DeferFunc(Program, inl,  prog)
+   DeferFunc(Program, opt,  prog)
+   DeferFunc(Program, tr,   prog)
+
+   DeferFunc(Function, flowFunc, func)
+   DeferFunc(Function, inlFunc,  func)
 
    DeferFuncSet(chk)
    DeferFuncSet(gen)
@@ -164,6 +164,15 @@ namespace GDCC::BC
 
    DeferFunc(Program, putExtra, prog)
 
+   //
+   // Info::pre
+   //
+   void Info::pre(IR::Program &prog_)
+   {
+      TryPointer(addFuncAll, prog);
+      TryPointer(pre, prog);
+   }
+
    //
    // Info::put
    //
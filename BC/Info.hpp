@@ -17,8 +17,10 @@
 
 #include "../Core/Counter.hpp"
 #include "../Core/Number.hpp"
+#include "../Core/String.hpp"
 
 #include <ostream>
+#include <unordered_set>
 
 
 //----------------------------------------------------------------------------|
@@ -167,8 +169,12 @@ namespace GDCC::BC
 
       void chk(IR::Program &prog);
 
+      void flow(IR::Program &prog);
+
       void gen(IR::Program &prog);
 
+      void inl(IR::Program &prog);
+
       void opt(IR::Program &prog);
 
       void pre(IR::Program &prog);
@@ -184,7 +190,6 @@ namespace GDCC::BC
       using IRExpCPtr = Core::CounterPtr<IR::Exp const>;
 
       class ResetFunc {};
-      class ResetStmnt {};
 
       class WordValue
       {
@@ -212,6 +217,10 @@ namespace GDCC::BC
       virtual void chkStrEnt() {}
               void chkStrEnt(IR::StrEnt &strent);
 
+      virtual void flow();
+      virtual void flowFunc();
+              void flowFunc(IR::Function &func);
+
       virtual void gen();
       virtual void genBlock();
               void genBlock(IR::Block &block);
@@ -228,6 +237,10 @@ namespace GDCC::BC
       virtual void genStrEnt() {}
               void genStrEnt(IR::StrEnt &strent);
 
+      virtual void inl();
+      virtual void inlFunc();
+              void inlFunc(IR::Function &func);
+
       virtual void opt();
       virtual void optBlock();
               void optBlock(IR::Block &block);
@@ -296,6 +309,8 @@ namespace GDCC::BC
 
       void addFunc(Core::String name, Core::FastU retrn, Core::FastU param);
 
+      void addFuncAll();
+
       void addFunc_Add_FW(Core::FastU n);
       void addFunc_Add_UW(Core::FastU n);
       void addFunc_Bclo_W(Core::FastU n);
@@ -355,6 +370,17 @@ namespace GDCC::BC
       [[noreturn]]
       void errorCode(char const *msg);
 
+      bool flowArgs(FlowFunc &flow);
+      bool flowArgs(FlowStmnt &fs, FlowFunc &flow, IR::Arg &arg,
+         bool def, bool use, bool lit, bool reg);
+
+      bool flowFunc_Alloc(FlowFunc &flow);
+      bool flowFunc_Dead(FlowFunc &flow);
+      bool flowFunc_Drop();
+      bool flowFunc_Prop(FlowFunc &flow);
+
+      bool foldStmnt();
+
       virtual FixedInfo getFixedInfo(Core::FastU n, bool s);
       FixedInfo getFixedInfo(Core::FastU n, char t);
 
@@ -371,6 +397,9 @@ namespace GDCC::BC
 
       virtual FixedInfo getIntegInfo(Core::FastU n, bool s);
 
+      bool getLocRegAddr(IR::Arg_LocReg const &arg, Core::FastU &addr);
+      bool getLocRegAddr(IR::Exp const *exp, Core::FastU &addr);
+
       virtual Core::FastU getStmntSize();
 
       Core::FastU getWord(IR::Arg_Lit const &arg, Core::FastU w = 0);
@@ -393,17 +422,25 @@ namespace GDCC::BC
       WordArray getWords_Tuple(IR::Exp_Tuple const *exp);
       WordArray getWords_Union(IR::Exp_Union const *exp);
 
+      bool isFuncExport(Core::String name);
+
+      bool inlArg(IR::Arg const &arg);
+      void inlArg(IR::Arg &arg, Core::FastU base, Core::String prefix,
+         IR::Function const &callee);
+      bool inlCallee(IR::Function const &callee);
+      bool inlStmnt(IR::Function const &callee, Core::FastU base, Core::String prefix);
+
       void putData(char const *data, std::size_t size);
 
       void moveArgStk_dst(IR::Arg &idx);
-      void moveArgStk_src(IR::Arg &idx);
+      bool moveArgStk_src(IR::Arg &idx);
 
       bool optStmnt_Cspe_Drop();
       bool optStmnt_JumpNext();
       bool optStmnt_LNot_Jcnd();
 
-      void trStmntStk2();
-      void trStmntStk3(bool ordered);
+      bool trStmntStk2();
+      bool trStmntStk3(bool ordered);
       bool trStmntShift(bool moveLit);
 
       IR::Block     *block;
@@ -417,6 +454,12 @@ namespace GDCC::BC
       IR::StrEnt    *strent;
       std::size_t    putPos;
 
+      // Functions defined by getFuncDefn.
+      std::unordered_set<Core::String> funcAdded;
+
+      // Functions defined by addFuncAll, for isFuncExport.
+      std::unordered_set<Core::String> funcExport;
+
    private:
       void addFunc_Add_UW(Core::FastU n, IR::Code codeAdd, IR::Code codeAdX);
       void addFunc_Bclz_W(Core::FastU n, IR::Code code, Core::FastU skip);
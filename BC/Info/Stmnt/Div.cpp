@@ -29,24 +29,7 @@ namespace GDCC::BC
    //
    void Info::addFunc_Div_AW(Core::FastU n)
    {
-      GDCC_BC_AddFuncPre((Code::Div+A, n), n, n * 2, n * 2, __FILE__);
-      GDCC_BC_AddFuncObjBin(n, n);
-
-      Core::FastU nf = n;
-      Core::FastU nd = n + nf;
-
-      GDCC_BC_AddStmnt(Code::Move,   nf, stk, 0);
-      GDCC_BC_AddStmnt(Code::Move,   n,  stk, lop);
-
-      GDCC_BC_AddStmnt(Code::Move,   n,  stk, rop);
-      GDCC_BC_AddStmnt(Code::Move,   nf, stk, 0);
-
-      GDCC_BC_AddStmnt(Code::DivX+U, nd, stk, stk, stk);
-      GDCC_BC_AddStmnt(Code::Move,   nf, nul, stk);
-
-      GDCC_BC_AddStmnt(Code::Retn,   n,  stk);
-
-      GDCC_BC_AddFuncEnd();
+      addFunc_Div_XW(n, IR::CodeBase::Div+'A', IR::CodeBase::Div+'U', false);
    }
 
    //
@@ -220,27 +203,7 @@ namespace GDCC::BC
    //
    void Info::addFunc_Div_RW(Core::FastU n)
    {
-      GDCC_BC_AddFuncPre((Code::Div+R, n), n, n * 2, n * 2, __FILE__);
-      GDCC_BC_AddFuncObjBin(n, n);
-
-      Core::FastU nf = n;
-      Core::FastU nd = n + nf;
-
-      GDCC_BC_AddStmnt(Code::Move,  nf, stk, 0);
-      GDCC_BC_AddStmnt(Code::Move,  n,  stk, lop);
-
-      GDCC_BC_AddStmnt(Code::Move,  n, stk, rop);
-      GDCC_BC_AddStmnt(Code::Copy,  1, stk, stk);
-      GDCC_BC_AddStmnt(Code::ShR+I, 1, stk, stk, 31);
-      for(Core::FastU i = nf - 1; i--;)
-         GDCC_BC_AddStmnt(Code::Copy, 1, stk, stk);
-
-      GDCC_BC_AddStmnt(Code::DivX+I, nd, stk, stk, stk);
-      GDCC_BC_AddStmnt(Code::Move,   nf, nul, stk);
-
-      GDCC_BC_AddStmnt(Code::Retn, n, stk);
-
-      GDCC_BC_AddFuncEnd();
+      addFunc_Div_XW(n, IR::CodeBase::Div+'R', IR::CodeBase::Div+'I', true);
    }
 
    //
@@ -259,7 +222,7 @@ namespace GDCC::BC
       GDCC_BC_AddFuncPre((code, n), n, n * 2, n * 2, __FILE__);
       GDCC_BC_AddFuncObjBin(n, n);
 
-      FixedInfo fi = getFixedInfo(n, sign);
+      FixedInfo fi = getFixedInfo(n, code.type[0]);
 
       Core::FastU nf = fi.wordsF;
       Core::FastU nd = n + nf;
@@ -12,11 +12,192 @@
 
 #include "BC/Info.hpp"
 
+#include "Core/Option.hpp"
+
+#include "IR/Block.hpp"
 #include "IR/Exception.hpp"
 #include "IR/Linkage.hpp"
 #include "IR/Program.hpp"
 
+#include "Option/Bool.hpp"
+#include "Option/CStr.hpp"
+
 #include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-addfunc-export
+   //
+   static Option::Bool AddFuncExport
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-addfunc-export")
+         .setGroup("codegen")
+         .setDescS("Generates every arithmetic helper function.")
+         .setDescL("Generates every arithmetic helper function, for "
+            "multi-word and software floating-point operations of up to three "
+            "words. Intended for building a library, such as libGDCC, for "
+            "other modules to import them from with --bc-addfunc-import."),
+
+      false
+   };
+
+   //
+   // --bc-addfunc-import
+   //
+   static Option::CStr AddFuncImport
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-addfunc-import")
+         .setGroup("codegen")
+         .setDescS("Imports arithmetic helper functions from a library.")
+         .setDescL("Imports arithmetic helper functions from a library. "
+            "Instead of generating its own copies of the helper functions "
+            "for multi-word and software floating-point operations, a "
+            "module declares them and imports the named library at runtime. "
+            "That library must have been built with --bc-addfunc-export.")
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::BC
+{
+   //
+   // AddFuncCodes
+   //
+   // Statements which may need a helper function, and their types.
+   //
+   static std::pair<IR::CodeBase, char const *> const AddFuncCodes[] =
+   {
+      {IR::CodeBase::Add,   "FIU"},
+      {IR::CodeBase::AddX,  "U"},
+      {IR::CodeBase::Bclo,  ""},
+      {IR::CodeBase::Bclz,  ""},
+      {IR::CodeBase::CmpEQ, "FIU"},
+      {IR::CodeBase::CmpGE, "FIU"},
+      {IR::CodeBase::CmpGT, "FIU"},
+      {IR::CodeBase::CmpLE, "FIU"},
+      {IR::CodeBase::CmpLT, "FIU"},
+      {IR::CodeBase::CmpNE, "FIU"},
+      {IR::CodeBase::Div,   "AFIKRUX"},
+      {IR::CodeBase::DivX,  "IU"},
+      {IR::CodeBase::Mod,   "IU"},
+      {IR::CodeBase::Mul,   "AFIKRUX"},
+      {IR::CodeBase::MulX,  "U"},
+      {IR::CodeBase::ShL,   "FIU"},
+      {IR::CodeBase::ShR,   "FIU"},
+      {IR::CodeBase::Sub,   "FIU"},
+      {IR::CodeBase::SubX,  "U"},
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // AddFuncEach
+   //
+   // Calls fn with the code and sizes of every statement that addFuncAll
+   // generates helpers for.
+   //
+   template<typename Fn>
+   static void AddFuncEach(Fn &&fn)
+   {
+      for(Core::FastU n = 1; n <= 3; ++n)
+      {
+         for(auto const &code : AddFuncCodes)
+         {
+            if(!*code.second)
+               fn(IR::Code{code.first}, n, n);
+
+            for(auto type = code.second; *type; ++type)
+               if(*type != 'F' || n <= 2)
+                  fn(IR::Code{code.first, *type}, n, n);
+         }
+      }
+
+      // Only conversions to or from floating-point use Tr. The other operand
+      // may be up to three words.
+      for(Core::FastU nf = 1; nf <= 2; ++nf)
+      {
+         for(auto type = "AFIKRUX"; *type; ++type)
+         {
+            for(Core::FastU n = 1; n <= 3; ++n)
+            {
+               if(*type == 'F' && (n == nf || n > 2))
+                  continue;
+
+               fn(IR::Code{IR::CodeBase::Tr, {'F', *type}}, nf, n);
+               fn(IR::Code{IR::CodeBase::Tr, {*type, 'F'}}, n, nf);
+            }
+         }
+      }
+   }
+
+   //
+   // AddFuncStmnt
+   //
+   static void AddFuncStmnt(IR::Block &block, IR::Code code,
+      Core::FastU dstN, Core::FastU srcN)
+   {
+      using Stk = IR::Block::Stk;
+
+      switch(code.base)
+      {
+      case IR::CodeBase::AddX:
+      case IR::CodeBase::SubX:
+         block.addStmnt(code, Stk(srcN + 1), Stk(srcN), Stk(srcN));
+         break;
+
+      case IR::CodeBase::Bclo:
+      case IR::CodeBase::Bclz:
+         block.addStmnt(code, Stk(1), Stk(srcN));
+         break;
+
+      case IR::CodeBase::CmpEQ:
+      case IR::CodeBase::CmpGE:
+      case IR::CodeBase::CmpGT:
+      case IR::CodeBase::CmpLE:
+      case IR::CodeBase::CmpLT:
+      case IR::CodeBase::CmpNE:
+         block.addStmnt(code, Stk(1), Stk(srcN), Stk(srcN));
+         break;
+
+      case IR::CodeBase::DivX:
+      case IR::CodeBase::MulX:
+         block.addStmnt(code, Stk(srcN * 2), Stk(srcN), Stk(srcN));
+         break;
+
+      case IR::CodeBase::ShL:
+      case IR::CodeBase::ShR:
+         block.addStmnt(code, Stk(srcN), Stk(srcN), Stk(1));
+         break;
+
+      case IR::CodeBase::Tr:
+         block.addStmnt(code, Stk(dstN), Stk(srcN));
+         break;
+
+      default:
+         block.addStmnt(code, Stk(srcN), Stk(srcN), Stk(srcN));
+         break;
+      }
+   }
+}
 
 
 //----------------------------------------------------------------------------|
@@ -48,6 +229,31 @@ namespace GDCC::BC
       }
    }
 
+   //
+   // Info::addFuncAll
+   //
+   // If exporting helper functions, generates them by preprocessing a block
+   // of every statement that might need one.
+   //
+   void Info::addFuncAll()
+   {
+      if(!AddFuncExport)
+         return;
+
+      IR::Block stmnts;
+      stmnts.setArgSize(Target::GetWordBytes());
+
+      AddFuncEach([&](IR::Code code, Core::FastU dstN, Core::FastU srcN)
+         {AddFuncStmnt(stmnts, code, dstN, srcN);});
+
+      for(;;) try
+      {
+         preBlock(stmnts);
+         break;
+      }
+      catch(ResetFunc const &) {}
+   }
+
    //
    // Info::getFuncDefn
    //
@@ -62,12 +268,21 @@ namespace GDCC::BC
       if(newFunc->defin)
          return nullptr;
 
+      // Leave the definition to the library, if it has one.
+      if(AddFuncImport.data() && !AddFuncExport && isFuncExport(name))
+      {
+         prog->getImport(Core::String{AddFuncImport.data()});
+         return nullptr;
+      }
+
       newFunc->defin    = true;
       newFunc->label    = name + "$label";
       newFunc->localReg = localReg;
 
       newFunc->block.setOrigin({file, 0});
 
+      funcAdded.insert(name);
+
       return newFunc;
    }
 
@@ -116,6 +331,29 @@ namespace GDCC::BC
 
       return {buf, len};
    }
+
+   //
+   // Info::isFuncExport
+   //
+   // Returns true if addFuncAll generates the named helper function. Helpers
+   // that it generates only for the use of others are not included, and so
+   // are generated locally when importing.
+   //
+   bool Info::isFuncExport(Core::String name)
+   {
+      if(funcExport.empty())
+      {
+         AddFuncEach([&](IR::Code code, Core::FastU dstN, Core::FastU srcN)
+         {
+            if(code.base == IR::CodeBase::Tr)
+               funcExport.insert(getFuncName(code, dstN, srcN));
+            else
+               funcExport.insert(getFuncName(code, srcN));
+         });
+      }
+
+      return funcExport.count(name);
+   }
 }
 
 // EOF
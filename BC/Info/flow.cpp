@@ -0,0 +1,324 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Function-level dataflow pass.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "BC/Flow.hpp"
+
+#include "IR/Exp/Binary.hpp"
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Function.hpp"
+#include "IR/Program.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FlowArgDst
+   //
+   // Returns true if the indicated argument is written by the statement.
+   //
+   static bool FlowArgDst(IR::Code code, std::size_t i)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Jcnd_Nil:
+      case IR::CodeBase::Jcnd_Tab:
+      case IR::CodeBase::Jcnd_Tru:
+      case IR::CodeBase::Jdyn:
+      case IR::CodeBase::Jfar_Pro:
+      case IR::CodeBase::Jfar_Set:
+      case IR::CodeBase::Jfar_Sta:
+      case IR::CodeBase::Jump:
+      case IR::CodeBase::Nop:
+      case IR::CodeBase::Retn:
+      case IR::CodeBase::Rjnk:
+      case IR::CodeBase::Xcod_SID:
+         return false;
+
+      case IR::CodeBase::Copy:
+      case IR::CodeBase::Swap:
+         return i <= 1;
+
+      default:
+         return i == 0;
+      }
+   }
+
+   //
+   // FlowArgSrc
+   //
+   // Returns true if the indicated argument is read by the statement.
+   //
+   static bool FlowArgSrc(IR::Code code, std::size_t i)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Bset:
+      case IR::CodeBase::Copy:
+      case IR::CodeBase::Swap:
+         return true;
+
+      default:
+         return !FlowArgDst(code, i);
+      }
+   }
+
+   //
+   // FlowArgRep
+   //
+   // Returns true if the indicated argument may be replaced by any other
+   // source argument of the same size.
+   //
+   static bool FlowArgRep(IR::Code code, std::size_t i)
+   {
+      switch(code.base)
+      {
+      case IR::CodeBase::Add:
+      case IR::CodeBase::BAnd:
+      case IR::CodeBase::BOrI:
+      case IR::CodeBase::BOrX:
+      case IR::CodeBase::CmpEQ:
+      case IR::CodeBase::CmpGE:
+      case IR::CodeBase::CmpGT:
+      case IR::CodeBase::CmpLE:
+      case IR::CodeBase::CmpLT:
+      case IR::CodeBase::CmpNE:
+      case IR::CodeBase::Div:
+      case IR::CodeBase::LAnd:
+      case IR::CodeBase::LOrI:
+      case IR::CodeBase::Mod:
+      case IR::CodeBase::Mul:
+      case IR::CodeBase::ShL:
+      case IR::CodeBase::ShR:
+      case IR::CodeBase::Sub:
+         return i == 1 || i == 2;
+
+      case IR::CodeBase::BNot:
+      case IR::CodeBase::Bclo:
+      case IR::CodeBase::Bclz:
+      case IR::CodeBase::LNot:
+      case IR::CodeBase::Move:
+      case IR::CodeBase::Neg:
+      case IR::CodeBase::Tr:
+         return i == 1;
+
+      case IR::CodeBase::Jcnd_Nil:
+      case IR::CodeBase::Jcnd_Tab:
+      case IR::CodeBase::Jcnd_Tru:
+      case IR::CodeBase::Retn:
+         return i == 0;
+
+      default:
+         return false;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::flow
+   //
+   void Info::flow()
+   {
+      for(auto &itr : prog->rangeFunction())
+         flowFunc(itr);
+   }
+
+   //
+   // Info::flowFunc
+   //
+   void Info::flowFunc()
+   {
+      if(!func->defin)
+         return;
+
+      // Each rewrite can expose more, so repeat until nothing changes. The
+      // limit only guards against pathological functions.
+      for(int i = 0; i != 8; ++i)
+      {
+         bool changed = false;
+
+         for(auto pass : {&Info::flowFunc_Prop, &Info::flowFunc_Dead})
+         {
+            FlowFunc flow{*func};
+            if(!flow.graph || !flowArgs(flow))
+               return;
+
+            changed |= (this->*pass)(flow);
+         }
+
+         changed |= flowFunc_Drop();
+
+         if(!changed)
+            break;
+      }
+
+      FlowFunc flow{*func};
+      if(flow.graph && flowArgs(flow))
+         flowFunc_Alloc(flow);
+   }
+
+   //
+   // Info::flowArgs
+   //
+   // Collects local register operands for every statement. Returns false if
+   // any operand cannot be resolved to a fixed address.
+   //
+   bool Info::flowArgs(FlowFunc &flow)
+   {
+      flow.stmnts.reserve(flow.graph.blocks.empty() ? 0 :
+         flow.graph.blocks.back().first + flow.graph.blocks.back().count);
+
+      for(auto &st : func->block)
+      {
+         flow.stmnts.emplace_back(&st);
+         auto &fs = flow.stmnts.back();
+
+         for(std::size_t i = 0, e = st.args.size(); i != e; ++i)
+         {
+            if(!flowArgs(fs, flow, st.args[i], FlowArgDst(st.code, i),
+               FlowArgSrc(st.code, i), FlowArgRep(st.code, i), FlowArgRep(st.code, i)))
+               return false;
+         }
+      }
+
+      return true;
+   }
+
+   //
+   // Info::flowArgs
+   //
+   bool Info::flowArgs(FlowStmnt &fs, FlowFunc &flow, IR::Arg &arg,
+      bool def, bool use, bool lit, bool reg)
+   {
+      //
+      // flowPtr1
+      //
+      auto flowPtr1 = [&](IR::ArgPtr1 &a, bool idxLit)
+      {
+         return flowArgs(fs, flow, *a.idx, false, true, idxLit, true);
+      };
+
+      //
+      // flowPtr2
+      //
+      auto flowPtr2 = [&](IR::ArgPtr2 &a)
+      {
+         return flowArgs(fs, flow, *a.arr, false, true, false, false) &&
+                flowArgs(fs, flow, *a.idx, false, true, true, true);
+      };
+
+      switch(arg.a)
+      {
+      case IR::ArgBase::LocReg:
+      {
+         Core::FastU addr;
+         if(!getLocRegAddr(arg.aLocReg, addr))
+            return false;
+
+         FlowArg fa;
+         fa.arg   = &arg;
+         fa.range = flow.getRange(addr, addr + arg.aLocReg.size);
+         fa.def   = def;
+         fa.use   = use;
+         fa.lit   = use && lit;
+         fa.reg   = use && reg;
+         fs.args.push_back(fa);
+      }
+         return true;
+
+      case IR::ArgBase::Aut:    return flowPtr1(arg.aAut,    true);
+      case IR::ArgBase::Far:    return flowPtr1(arg.aFar,    false);
+      case IR::ArgBase::Gen:    return flowPtr1(arg.aGen,    false);
+      case IR::ArgBase::GblArs: return flowPtr1(arg.aGblArs, false);
+      case IR::ArgBase::GblReg: return flowPtr1(arg.aGblReg, false);
+      case IR::ArgBase::HubArs: return flowPtr1(arg.aHubArs, false);
+      case IR::ArgBase::HubReg: return flowPtr1(arg.aHubReg, false);
+      case IR::ArgBase::ModArs: return flowPtr1(arg.aModArs, false);
+      case IR::ArgBase::ModReg: return flowPtr1(arg.aModReg, false);
+      case IR::ArgBase::Sta:    return flowPtr1(arg.aSta,    true);
+      case IR::ArgBase::StrArs: return flowPtr1(arg.aStrArs, false);
+      case IR::ArgBase::Vaa:    return flowPtr1(arg.aVaa,    false);
+
+      case IR::ArgBase::GblArr: return flowPtr2(arg.aGblArr);
+      case IR::ArgBase::HubArr: return flowPtr2(arg.aHubArr);
+      case IR::ArgBase::LocArr: return flowPtr2(arg.aLocArr);
+      case IR::ArgBase::ModArr: return flowPtr2(arg.aModArr);
+      case IR::ArgBase::StrArr: return flowPtr2(arg.aStrArr);
+
+      default:
+         return true;
+      }
+   }
+
+   //
+   // Info::getLocRegAddr
+   //
+   // Resolves the address of a local register operand ahead of glyph backing.
+   //
+   bool Info::getLocRegAddr(IR::Arg_LocReg const &arg, Core::FastU &addr)
+   {
+      if(arg.idx->a != IR::ArgBase::Lit || arg.idx->aLit.off)
+         return false;
+
+      if(!getLocRegAddr(arg.idx->aLit.value, addr))
+         return false;
+
+      addr += arg.off;
+      return true;
+   }
+
+   //
+   // Info::getLocRegAddr
+   //
+   bool Info::getLocRegAddr(IR::Exp const *exp, Core::FastU &addr)
+   {
+      if(exp->isValue())
+         return addr = getWord(exp), true;
+
+      // Local objects are not backed until gen, but their index is known.
+      // Allocated ones are never given a local register index by any
+      // target, so they cannot be resolved.
+      if(auto e = dynamic_cast<IR::Exp_Glyph const *>(exp))
+      {
+         auto o = prog->findObject(e->glyph);
+         if(!o || o->alloc || o->space.base != IR::AddrBase::LocReg)
+            return false;
+
+         return addr = o->value, true;
+      }
+
+      if(auto e = dynamic_cast<IR::Exp_AddPtrRaw const *>(exp))
+      {
+         if(!e->expR->isValue() || !getLocRegAddr(e->expL, addr))
+            return false;
+
+         return addr += getWord(e->expR), true;
+      }
+
+      return false;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,318 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Local register allocation.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "BC/Flow.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Function.hpp"
+
+#include "Option/Bool.hpp"
+
+#include "Target/Info.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-flow-alloc
+   //
+   static Option::Bool OptFlowAlloc
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-flow-alloc")
+         .setGroup("codegen")
+         .setDescS("Enables or disables liveness-based local register "
+            "allocation.")
+         .setDescL("Enables or disables liveness-based local register "
+            "allocation. Skips the same functions as --bc-flow-prop."),
+
+      true
+   };
+
+   //
+   // --bc-flow-alloc-report
+   //
+   static Option::Bool OptFlowAllocReport
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-flow-alloc-report")
+         .setGroup("debugging")
+         .setDescS("Reports local registers saved by allocation.")
+         .setDescL("Reports local registers saved by allocation. For each "
+            "function with fewer registers after allocation, the old and "
+            "new counts are written to stderr."),
+
+      false
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FlowSlot
+   //
+   // A maximal set of overlapping register ranges, allocated as a unit.
+   //
+   class FlowSlot
+   {
+   public:
+      Core::FastU lo, hi;
+      Core::FastU base; // New lo.
+
+      std::vector<std::size_t> edges;
+
+      bool alloc; // Base has been assigned.
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::flowFunc_Alloc
+   //
+   // Reassigns local registers so that values which are never live at the
+   // same time share registers. Parameters keep their registers.
+   //
+   bool Info::flowFunc_Alloc(FlowFunc &flow)
+   {
+      if(!OptFlowAlloc)
+         return false;
+
+      auto &blocks    = flow.graph.blocks;
+      auto  rangeC    = flow.ranges.size();
+      auto  wordBytes = Target::GetWordBytes();
+      auto  paramEnd  = func->param * wordBytes;
+
+      // Group overlapping ranges into slots.
+      std::vector<FlowSlot>    slots;
+      std::vector<std::size_t> rangeSlot(rangeC);
+      {
+         std::vector<std::size_t> order(rangeC);
+         for(std::size_t r = 0; r != rangeC; ++r) order[r] = r;
+
+         std::sort(order.begin(), order.end(), [&](std::size_t l, std::size_t r)
+            {return flow.ranges[l].lo < flow.ranges[r].lo;});
+
+         for(auto r : order)
+         {
+            auto const &range = flow.ranges[r];
+
+            if(slots.empty() || slots.back().hi <= range.lo)
+               slots.push_back({range.lo, range.hi, range.lo, {}, false});
+            else
+               slots.back().hi = std::max(slots.back().hi, range.hi);
+
+            rangeSlot[r] = slots.size() - 1;
+         }
+      }
+
+      auto slotC = slots.size();
+
+      // Parameters, and anything not word aligned, stay where they are.
+      for(auto &slot : slots)
+      {
+         if(slot.lo < paramEnd || slot.lo % wordBytes)
+            slot.alloc = true;
+      }
+
+      //
+      // transfer
+      //
+      auto transfer = [&](FlowStmnt const &fs, FlowSet &live)
+      {
+         for(auto const &fa : fs.args) if(fa.def && !fa.use)
+         {
+            auto s = rangeSlot[fa.range];
+            if(flow.ranges[fa.range].lo == slots[s].lo &&
+               flow.ranges[fa.range].hi == slots[s].hi)
+               live.reset(s);
+         }
+
+         for(auto const &fa : fs.args)
+            if(fa.use) live.set(rangeSlot[fa.range]);
+      };
+
+      // Solve liveness.
+      std::vector<FlowSet> liveIn (blocks.size(), FlowSet{slotC});
+      std::vector<FlowSet> liveOut(blocks.size(), FlowSet{slotC});
+
+      for(bool changed = true; changed;)
+      {
+         changed = false;
+
+         for(std::size_t b = blocks.size(); b--;)
+         {
+            FlowSet live{slotC};
+            for(auto s : blocks[b].succ)
+               live |= liveIn[s];
+
+            liveOut[b] = live;
+
+            auto fsBeg = flow.stmnts.begin() + blocks[b].first;
+            for(auto fsItr = fsBeg + blocks[b].count; fsItr != fsBeg;)
+               transfer(*--fsItr, live);
+
+            if(live != liveIn[b])
+               liveIn[b] = std::move(live), changed = true;
+         }
+      }
+
+      // Build interference graph.
+      std::vector<FlowSet> interfere(slotC, FlowSet{slotC});
+
+      //
+      // addEdges
+      //
+      auto addEdges = [&](std::size_t s, FlowSet const &live)
+      {
+         interfere[s] |= live;
+         for(auto i = live.find(); i != FlowSet::npos; i = live.find(i + 1))
+            interfere[i].set(s);
+      };
+
+      for(std::size_t b = 0; b != blocks.size(); ++b)
+      {
+         FlowSet live = liveOut[b];
+
+         auto fsBeg = flow.stmnts.begin() + blocks[b].first;
+         for(auto fsItr = fsBeg + blocks[b].count; fsItr != fsBeg;)
+         {
+            --fsItr;
+
+            // Anything written must not clobber a value still needed. Operands
+            // of the same statement are kept apart, as multi-word statements
+            // may write some words before reading others.
+            FlowSet used{slotC};
+            for(auto const &fa : fsItr->args)
+               if(fa.use) used.set(rangeSlot[fa.range]);
+
+            for(auto const &fa : fsItr->args) if(fa.def)
+            {
+               addEdges(rangeSlot[fa.range], live);
+               addEdges(rangeSlot[fa.range], used);
+            }
+
+            transfer(*fsItr, live);
+         }
+      }
+
+      // Values live on entry are all live at once.
+      if(!blocks.empty())
+      {
+         auto const &live = liveIn[0];
+         for(auto i = live.find(); i != FlowSet::npos; i = live.find(i + 1))
+            addEdges(i, live);
+      }
+
+      for(std::size_t s = 0; s != slotC; ++s)
+      {
+         interfere[s].reset(s);
+         for(auto i = interfere[s].find(); i != FlowSet::npos; i = interfere[s].find(i + 1))
+            slots[s].edges.push_back(i);
+      }
+
+      // Assign each slot the lowest free registers above the parameters.
+      for(auto &slot : slots)
+      {
+         if(slot.alloc)
+            continue;
+
+         auto size = slot.hi - slot.lo;
+         auto base = paramEnd;
+
+         for(bool moved = true; moved;)
+         {
+            moved = false;
+
+            for(auto e : slot.edges)
+            {
+               auto const &other = slots[e];
+               if(!other.alloc)
+                  continue;
+
+               auto otherHi = other.base + (other.hi - other.lo);
+               if(base < otherHi && other.base < base + size)
+               {
+                  base  = (otherHi + wordBytes - 1) / wordBytes * wordBytes;
+                  moved = true;
+               }
+            }
+         }
+
+         slot.base  = base;
+         slot.alloc = true;
+      }
+
+      // Rewrite operands.
+      bool res = false;
+
+      for(auto &fs : flow.stmnts)
+      {
+         for(auto const &fa : fs.args)
+         {
+            auto const &slot = slots[rangeSlot[fa.range]];
+            if(slot.base == slot.lo)
+               continue;
+
+            auto &arg = fa.arg->aLocReg;
+            auto  idx = slot.base + (flow.ranges[fa.range].lo - slot.lo);
+
+            *arg.idx = IR::Arg_Lit(arg.idx->aLit.size, func->block.getExp(idx));
+            arg.off  = 0;
+
+            res = true;
+         }
+      }
+
+      // Lower register count.
+      Core::FastU addrEnd = 0;
+      for(auto const &slot : slots)
+         addrEnd = std::max(addrEnd, slot.base + (slot.hi - slot.lo));
+
+      auto localReg = FlowLocalReg(*func, addrEnd);
+      if(localReg < func->localReg)
+      {
+         if(OptFlowAllocReport)
+         {
+            std::cerr << func->glyph << ": " << func->localReg << " -> "
+               << localReg << " registers\n";
+         }
+
+         func->localReg = localReg;
+      }
+
+      return res;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,323 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Dead store elimination of local registers.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "BC/Flow.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Function.hpp"
+
+#include "Option/Bool.hpp"
+
+#include <algorithm>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-flow-dead
+   //
+   static Option::Bool OptFlowDead
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-flow-dead")
+         .setGroup("codegen")
+         .setDescS("Enables or disables dead store elimination of local "
+            "registers.")
+         .setDescL("Enables or disables dead store elimination of local "
+            "registers. Skips the same functions as --bc-flow-prop."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // IsFlowPure
+   //
+   // Returns true if stmnt has no effect other than writing its first arg.
+   //
+   static bool IsFlowPure(IR::Statement const *stmnt)
+   {
+      switch(stmnt->code.base)
+      {
+      case IR::CodeBase::Add:
+      case IR::CodeBase::AddX:
+      case IR::CodeBase::BAnd:
+      case IR::CodeBase::BNot:
+      case IR::CodeBase::BOrI:
+      case IR::CodeBase::BOrX:
+      case IR::CodeBase::Bclo:
+      case IR::CodeBase::Bclz:
+      case IR::CodeBase::Bges:
+      case IR::CodeBase::Bget:
+      case IR::CodeBase::CmpEQ:
+      case IR::CodeBase::CmpGE:
+      case IR::CodeBase::CmpGT:
+      case IR::CodeBase::CmpLE:
+      case IR::CodeBase::CmpLT:
+      case IR::CodeBase::CmpNE:
+      case IR::CodeBase::LAnd:
+      case IR::CodeBase::LNot:
+      case IR::CodeBase::LOrI:
+      case IR::CodeBase::Move:
+      case IR::CodeBase::Mul:
+      case IR::CodeBase::MulX:
+      case IR::CodeBase::Neg:
+      case IR::CodeBase::Pltn:
+      case IR::CodeBase::ShL:
+      case IR::CodeBase::ShR:
+      case IR::CodeBase::Sub:
+      case IR::CodeBase::SubX:
+      case IR::CodeBase::Tr:
+         break;
+
+      default:
+         return false;
+      }
+
+      // Memory reads are kept, as they might be volatile.
+      for(auto arg = stmnt->args.begin() + 1, end = stmnt->args.end(); arg != end; ++arg)
+      {
+         switch(arg->a)
+         {
+         case IR::ArgBase::Lit:
+         case IR::ArgBase::LocReg:
+         case IR::ArgBase::Stk:
+            break;
+
+         default:
+            return false;
+         }
+      }
+
+      return true;
+   }
+
+   //
+   // FlowDrop
+   //
+   // Replaces a pure statement whose result is unused with a drop of its
+   // stack operands, or removes it if there are none.
+   //
+   static void FlowDrop(IR::Block &block, IR::Statement *stmnt)
+   {
+      Core::FastU n = 0;
+      for(auto arg = stmnt->args.begin() + 1, end = stmnt->args.end(); arg != end; ++arg)
+         if(arg->a == IR::ArgBase::Stk) n += arg->aStk.size;
+
+      if(!n)
+         return FlowRemove(block, stmnt);
+
+      stmnt->code = IR::CodeBase::Move;
+      stmnt->args = {Core::Pack, IR::Arg_Nul(n), IR::Arg_Stk(n)};
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::flowFunc_Dead
+   //
+   // Removes writes to local registers that are not read before being
+   // written again or the function returning. Also lowers the function's
+   // register count if the highest registers are no longer used.
+   //
+   bool Info::flowFunc_Dead(FlowFunc &flow)
+   {
+      if(!OptFlowDead)
+         return false;
+
+      auto &blocks = flow.graph.blocks;
+      auto  rangeC = flow.ranges.size();
+
+      Core::FastU addrC = 0;
+      for(auto const &range : flow.ranges)
+         addrC = std::max(addrC, range.hi);
+
+      // Addresses covered by each range.
+      std::vector<FlowSet> mask(rangeC, FlowSet{addrC});
+      for(std::size_t r = 0; r != rangeC; ++r)
+      {
+         for(auto a = flow.ranges[r].lo; a != flow.ranges[r].hi; ++a)
+            mask[r].set(a);
+      }
+
+      //
+      // isDead
+      //
+      auto isDead = [&](FlowStmnt const &fs, FlowSet const &live)
+      {
+         if(!IsFlowPure(fs.stmnt))
+            return false;
+
+         auto dst = &fs.stmnt->args[0];
+         if(dst->a == IR::ArgBase::Nul)
+            return true;
+
+         for(auto const &fa : fs.args) if(fa.arg == dst)
+         {
+            FlowSet used = live;
+            return !(used &= mask[fa.range]).any();
+         }
+
+         return false;
+      };
+
+      //
+      // transfer
+      //
+      auto transfer = [&](FlowStmnt const &fs, FlowSet &live)
+      {
+         for(auto const &fa : fs.args)
+            if(fa.def && !fa.use) live.sub(mask[fa.range]);
+
+         for(auto const &fa : fs.args)
+            if(fa.use) live |= mask[fa.range];
+      };
+
+      // Solve liveness.
+      std::vector<FlowSet> liveIn (blocks.size(), FlowSet{addrC});
+      std::vector<FlowSet> liveOut(blocks.size(), FlowSet{addrC});
+
+      for(bool changed = true; changed;)
+      {
+         changed = false;
+
+         for(std::size_t b = blocks.size(); b--;)
+         {
+            FlowSet live{addrC};
+            for(auto s : blocks[b].succ)
+               live |= liveIn[s];
+
+            liveOut[b] = live;
+
+            auto fsBeg = flow.stmnts.begin() + blocks[b].first;
+            for(auto fsItr = fsBeg + blocks[b].count; fsItr != fsBeg;)
+            {
+               --fsItr;
+               if(!isDead(*fsItr, live))
+                  transfer(*fsItr, live);
+            }
+
+            if(live != liveIn[b])
+               liveIn[b] = std::move(live), changed = true;
+         }
+      }
+
+      // Remove dead statements.
+      bool res = false;
+
+      for(std::size_t b = 0; b != blocks.size(); ++b)
+      {
+         FlowSet live = liveOut[b];
+
+         auto fsBeg = flow.stmnts.begin() + blocks[b].first;
+         for(auto fsItr = fsBeg + blocks[b].count; fsItr != fsBeg;)
+         {
+            --fsItr;
+            if(isDead(*fsItr, live))
+            {
+               // Nul destinations are left to flowFunc_Drop.
+               if(fsItr->stmnt->args[0].a == IR::ArgBase::Nul)
+                  continue;
+
+               FlowDrop(func->block, fsItr->stmnt);
+               res = true;
+            }
+            else
+               transfer(*fsItr, live);
+         }
+      }
+
+      // Lower register count.
+      auto localReg = FlowLocalReg(*func, addrC);
+      if(localReg < func->localReg)
+         func->localReg = localReg;
+
+      return res;
+   }
+
+   //
+   // Info::flowFunc_Drop
+   //
+   // The sequence:
+   //    Code(Stk N() ...)
+   //    Move(Nul N() Stk N())
+   // Where Code is pure, can be transformed into a drop of Code's stack
+   // operands. Pure statements writing Nul are also removed.
+   //
+   bool Info::flowFunc_Drop()
+   {
+      if(!OptFlowDead)
+         return false;
+
+      bool res = false;
+
+      for(auto itr = func->block.begin(), end = func->block.end(); itr != end;)
+      {
+         auto st = &*itr++;
+
+         if(st->args.empty() || !IsFlowPure(st))
+            continue;
+
+         if(st->args[0].a == IR::ArgBase::Nul)
+         {
+            if(st->code == IR::CodeBase::Move && st->args[1].a == IR::ArgBase::Stk)
+               continue;
+
+            FlowDrop(func->block, st);
+            res = true;
+            continue;
+         }
+
+         if(st->args[0].a != IR::ArgBase::Stk || itr == end)
+            continue;
+
+         auto next = &*itr;
+
+         // Must be followed by an unlabelled Move(Nul N() Stk N()).
+         auto n = st->args[0].aStk.size;
+         if(!next->labs.empty() || next->code != IR::CodeBase::Move ||
+            next->args[0].a != IR::ArgBase::Nul || next->args[0].aNul.size != n ||
+            next->args[1].a != IR::ArgBase::Stk || next->args[1].aStk.size != n)
+            continue;
+
+         ++itr;
+         delete next;
+         FlowDrop(func->block, st);
+         res = true;
+      }
+
+      return res;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,420 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Constant and copy propagation of local registers.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "BC/Flow.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Function.hpp"
+
+#include "Option/Bool.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-flow-prop
+   //
+   static Option::Bool OptFlowProp
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-flow-prop")
+         .setGroup("codegen")
+         .setDescS("Enables or disables constant and copy propagation of "
+            "local registers.")
+         .setDescL("Enables or disables constant and copy propagation of "
+            "local registers. Only functions whose local registers all have "
+            "an index set by the front end are changed. Objects left for the "
+            "back end to allocate are never given a local register index, so "
+            "functions using one are skipped by this and the other flow "
+            "passes."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FlowDef
+   //
+   // A definition of a local register range. Every range also has an entry
+   // definition standing for its value on function entry.
+   //
+   class FlowDef
+   {
+   public:
+      enum Kind
+      {
+         Entry,
+         Lit,
+         Copy,
+         Other,
+      };
+
+      FlowDef(std::size_t range_, Kind kind_) :
+         range{range_}, kind{kind_}, src{}, srcRange{0}, copy{0} {}
+
+      std::size_t range;
+      Kind        kind;
+      IR::Arg     src;      // Source for Lit and Copy.
+      std::size_t srcRange; // Source range for Copy.
+      std::size_t copy;     // Index of copy for Copy.
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GetFlowArg
+   //
+   static FlowArg const *GetFlowArg(FlowStmnt const &fs, IR::Arg const *arg)
+   {
+      for(auto const &fa : fs.args)
+         if(fa.arg == arg) return &fa;
+
+      return nullptr;
+   }
+
+   //
+   // GetFlowDef
+   //
+   static FlowDef GetFlowDef(FlowFunc const &flow, FlowStmnt const &fs,
+      FlowArg const &fa)
+   {
+      auto st = fs.stmnt;
+
+      if(st->code != IR::CodeBase::Move || fa.arg != &st->args[0])
+         return {fa.range, FlowDef::Other};
+
+      auto &src = st->args[1];
+
+      if(src.a == IR::ArgBase::Lit)
+      {
+         FlowDef def{fa.range, FlowDef::Lit};
+         def.src = src;
+         return def;
+      }
+
+      if(src.a == IR::ArgBase::LocReg)
+      {
+         auto srcArg = GetFlowArg(fs, &src);
+         if(!srcArg || !srcArg->reg)
+            return {fa.range, FlowDef::Other};
+
+         // Overlapping copies would be invalidated by their own definition.
+         if(flow.ranges[fa.range].overlaps(flow.ranges[srcArg->range]))
+            return {fa.range, FlowDef::Other};
+
+         FlowDef def{fa.range, FlowDef::Copy};
+         def.src      = src;
+         def.srcRange = srcArg->range;
+         return def;
+      }
+
+      return {fa.range, FlowDef::Other};
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::flowFunc_Prop
+   //
+   // Rewrites local register reads whose value is known to be a literal or a
+   // copy of another local register. Returns true if anything was changed.
+   //
+   bool Info::flowFunc_Prop(FlowFunc &flow)
+   {
+      if(!OptFlowProp)
+         return false;
+
+      auto &blocks = flow.graph.blocks;
+      auto  rangeC = flow.ranges.size();
+
+      // Collect definitions.
+      std::vector<FlowDef> defs;
+      std::vector<FlowDef> copies;
+
+      for(std::size_t r = 0; r != rangeC; ++r)
+         defs.emplace_back(r, FlowDef::Entry);
+
+      for(auto const &fs : flow.stmnts)
+      {
+         for(auto const &fa : fs.args) if(fa.def)
+         {
+            defs.push_back(GetFlowDef(flow, fs, fa));
+
+            if(defs.back().kind == FlowDef::Copy)
+            {
+               defs.back().copy = copies.size();
+               copies.push_back(defs.back());
+            }
+         }
+      }
+
+      auto defC  = defs.size();
+      auto copyC = copies.size();
+
+      // Definitions killed by, and relevant to, each range.
+      std::vector<FlowSet> contain(rangeC, FlowSet{defC});
+      std::vector<FlowSet> overlap(rangeC, FlowSet{defC});
+      std::vector<FlowSet> killCpy(rangeC, FlowSet{copyC});
+      {
+         std::vector<FlowSet> byRange(rangeC, FlowSet{defC});
+         for(std::size_t d = 0; d != defC; ++d)
+            byRange[defs[d].range].set(d);
+
+         for(std::size_t r = 0; r != rangeC; ++r)
+         {
+            auto const &range = flow.ranges[r];
+
+            for(std::size_t s = 0; s != rangeC; ++s)
+            {
+               if(range.contains(flow.ranges[s]))
+                  contain[r] |= byRange[s];
+
+               if(range.overlaps(flow.ranges[s]))
+                  overlap[r] |= byRange[s];
+            }
+
+            for(std::size_t c = 0; c != copyC; ++c)
+            {
+               if(range.overlaps(flow.ranges[copies[c].range]) ||
+                  range.overlaps(flow.ranges[copies[c].srcRange]))
+                  killCpy[r].set(c);
+            }
+         }
+      }
+
+      // Compute block transfer functions.
+      std::vector<std::size_t> blockDef(blocks.size());
+      std::vector<FlowSet>     defGen (blocks.size(), FlowSet{defC});
+      std::vector<FlowSet>     defKill(blocks.size(), FlowSet{defC});
+      std::vector<FlowSet>     cpyGen (blocks.size(), FlowSet{copyC});
+      std::vector<FlowSet>     cpyKill(blocks.size(), FlowSet{copyC});
+
+      for(std::size_t b = 0, d = rangeC; b != blocks.size(); ++b)
+      {
+         blockDef[b] = d;
+
+         auto fsItr = flow.stmnts.begin() + blocks[b].first;
+         auto fsEnd = fsItr + blocks[b].count;
+         for(; fsItr != fsEnd; ++fsItr)
+         {
+            for(auto const &fa : fsItr->args) if(fa.def)
+            {
+               defGen[b].sub(contain[fa.range]);
+               defKill[b] |= contain[fa.range];
+               defGen[b].set(d);
+
+               cpyGen[b].sub(killCpy[fa.range]);
+               cpyKill[b] |= killCpy[fa.range];
+               if(defs[d].kind == FlowDef::Copy)
+                  cpyGen[b].set(defs[d].copy);
+
+               ++d;
+            }
+         }
+      }
+
+      // Solve reaching definitions and available copies.
+      std::vector<FlowSet> defIn (blocks.size(), FlowSet{defC});
+      std::vector<FlowSet> defOut(blocks.size(), FlowSet{defC});
+      std::vector<FlowSet> cpyIn (blocks.size(), FlowSet{copyC});
+      std::vector<FlowSet> cpyOut(blocks.size(), FlowSet{copyC});
+
+      FlowSet cpyAll{copyC};
+      for(std::size_t c = 0; c != copyC; ++c)
+         cpyAll.set(c);
+
+      for(std::size_t b = 0; b != blocks.size(); ++b)
+         cpyOut[b] = cpyAll;
+
+      for(bool changed = true; changed;)
+      {
+         changed = false;
+
+         for(std::size_t b = 0; b != blocks.size(); ++b)
+         {
+            FlowSet in{defC};
+            FlowSet inCpy{copyC};
+
+            if(b == 0)
+            {
+               for(std::size_t r = 0; r != rangeC; ++r)
+                  in.set(r);
+            }
+            else if(!blocks[b].pred.empty())
+               inCpy = cpyAll;
+
+            for(auto p : blocks[b].pred)
+            {
+               in    |= defOut[p];
+               inCpy &= cpyOut[p];
+            }
+
+            if(b == 0)
+               inCpy.clear();
+
+            FlowSet outDef = in;
+            outDef.sub(defKill[b]) |= defGen[b];
+
+            FlowSet outCpy = inCpy;
+            outCpy.sub(cpyKill[b]) |= cpyGen[b];
+
+            if(outDef != defOut[b] || outCpy != cpyOut[b])
+               changed = true;
+
+            defIn[b]  = std::move(in);
+            defOut[b] = std::move(outDef);
+            cpyIn[b]  = std::move(inCpy);
+            cpyOut[b] = std::move(outCpy);
+         }
+      }
+
+      // Rewrite uses.
+      bool res = false;
+
+      for(std::size_t b = 0; b != blocks.size(); ++b)
+      {
+         FlowSet cur    = defIn[b];
+         FlowSet curCpy = cpyIn[b];
+         auto    d      = blockDef[b];
+
+         auto fsItr = flow.stmnts.begin() + blocks[b].first;
+         auto fsEnd = fsItr + blocks[b].count;
+         for(; fsItr != fsEnd; ++fsItr)
+         {
+            for(auto const &fa : fsItr->args)
+            {
+               if(!fa.use || (!fa.lit && !fa.reg))
+                  continue;
+
+               FlowSet rel = cur;
+               rel &= overlap[fa.range];
+
+               // Constant: every reaching definition is the same literal.
+               if(fa.lit)
+               {
+                  FlowDef const *lit = nullptr;
+                  for(auto i = rel.find(); i != FlowSet::npos; i = rel.find(i + 1))
+                  {
+                     auto const &def = defs[i];
+                     if(def.kind != FlowDef::Lit || def.range != fa.range ||
+                        (lit && !(def.src == lit->src)))
+                        {lit = nullptr; break;}
+
+                     lit = &def;
+                  }
+
+                  if(lit)
+                  {
+                     *fa.arg = lit->src;
+                     res = true;
+                     continue;
+                  }
+               }
+
+               // Copy: an available copy defines exactly this range.
+               if(fa.reg)
+               {
+                  for(auto i = curCpy.find(); i != FlowSet::npos; i = curCpy.find(i + 1))
+                  {
+                     if(copies[i].range == fa.range)
+                     {
+                        *fa.arg = copies[i].src;
+                        res = true;
+                        break;
+                     }
+                  }
+               }
+            }
+
+            for(auto const &fa : fsItr->args) if(fa.def)
+            {
+               cur.sub(contain[fa.range]);
+               cur.set(d);
+
+               curCpy.sub(killCpy[fa.range]);
+               if(defs[d].kind == FlowDef::Copy)
+                  curCpy.set(defs[d].copy);
+
+               ++d;
+            }
+         }
+      }
+
+      // Remove redundant statements.
+      for(auto itr = func->block.begin(), end = func->block.end(); itr != end;)
+      {
+         auto st = &*itr++;
+
+         switch(st->code.base)
+         {
+         case IR::CodeBase::Move:
+            if(st->args[0].a == IR::ArgBase::LocReg && st->args[0] == st->args[1])
+               FlowRemove(func->block, st), res = true;
+            break;
+
+         case IR::CodeBase::Jcnd_Nil:
+         case IR::CodeBase::Jcnd_Tru:
+            if(st->args[0].a == IR::ArgBase::Lit && st->args[0].aLit.value->isValue())
+            {
+               bool tru = false;
+               for(auto const &w : getWords(st->args[0].aLit))
+                  if(w.exp || w.val) {tru = true; break;}
+
+               if(tru == (st->code.base == IR::CodeBase::Jcnd_Tru))
+               {
+                  st->code = IR::CodeBase::Jump;
+                  st->args = {Core::Pack, std::move(st->args[1])};
+               }
+               else
+                  FlowRemove(func->block, st);
+
+               res = true;
+            }
+            break;
+
+         default:
+            break;
+         }
+      }
+
+      return res;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,478 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Constant folding of statements with literal operands.
+//
+// Statements that would otherwise call an arithmetic helper function are
+// evaluated at link time and replaced with a Move of the result. Integer
+// results wrap as the helpers do. Floating results are only folded when
+// exact, so that the helpers' rounding never needs to be reproduced.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Exp.hpp"
+#include "IR/Statement.hpp"
+
+#include "Option/Bool.hpp"
+
+#include "Target/Info.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-fold
+   //
+   static Option::Bool OptFold
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-fold")
+         .setGroup("codegen")
+         .setDescS("Enables or disables constant folding of statements.")
+         .setDescL("Enables or disables constant folding of statements. "
+            "Multi-word and floating-point arithmetic and conversions with "
+            "only literal operands are evaluated instead of calling helper "
+            "functions. Default is on."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FoldFloat
+   //
+   // A floating value, (-1)**sig * man * 2**exp.
+   //
+   class FoldFloat
+   {
+   public:
+      Core::Integ man;
+      Core::FastI exp;
+      bool        sig;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // FoldMask
+   //
+   static Core::Integ FoldMask(Core::FastU bits)
+   {
+      Core::Integ mask = 1;
+      mask <<= bits;
+      return --mask;
+   }
+
+   //
+   // FoldFloatGet
+   //
+   // Returns false for values that are not normal, except for zero if
+   // allowed.
+   //
+   static bool FoldFloatGet(Core::Integ const &bits, FloatInfo const &fi,
+      FoldFloat &out, bool zero = false)
+   {
+      auto exp = Core::NumberCast<Core::FastU>(
+         (bits >> fi.bitsManFull) & Core::NumberCast<Core::Integ>(fi.maxExp));
+
+      out.man = bits & FoldMask(fi.bitsManFull);
+      out.sig = fi.bitsSig &&
+         mpz_tstbit(bits.get_mpz_t(), fi.bitsManFull + fi.bitsExp);
+
+      if(exp == 0)
+      {
+         out.exp = 0;
+         return zero && out.man == 0;
+      }
+
+      if(exp == fi.maxExp)
+         return false;
+
+      mpz_setbit(out.man.get_mpz_t(), fi.bitsManFull);
+      out.exp = static_cast<Core::FastI>(exp) -
+         static_cast<Core::FastI>(fi.offExp + fi.bitsManFull);
+
+      return true;
+   }
+
+   //
+   // FoldFloatPut
+   //
+   // Returns false if the value is not exactly representable as a normal
+   // value.
+   //
+   static bool FoldFloatPut(FoldFloat val, FloatInfo const &fi, Core::Integ &out)
+   {
+      if(val.man == 0 || (val.sig && !fi.bitsSig))
+         return false;
+
+      // Remove trailing zeroes, then check that the mantissa fits.
+      auto tz = mpz_scan1(val.man.get_mpz_t(), 0);
+      val.man >>= tz;
+      val.exp  += static_cast<Core::FastI>(tz);
+
+      Core::FastU len = mpz_sizeinbase(val.man.get_mpz_t(), 2);
+      if(len > fi.bitsManFull + 1)
+         return false;
+
+      val.man <<= fi.bitsManFull + 1 - len;
+      val.exp  -= static_cast<Core::FastI>(fi.bitsManFull + 1 - len);
+
+      auto exp = val.exp + static_cast<Core::FastI>(fi.offExp + fi.bitsManFull);
+      if(exp <= 0 || exp >= static_cast<Core::FastI>(fi.maxExp))
+         return false;
+
+      out   = val.sig;
+      out <<= fi.bitsExp;
+      out  += Core::NumberCast<Core::Integ>(exp);
+      out <<= fi.bitsManFull;
+      out  |= val.man & FoldMask(fi.bitsManFull);
+
+      return true;
+   }
+
+   //
+   // FoldFloatToInteg
+   //
+   // Truncates toward zero.
+   //
+   static Core::Integ FoldFloatToInteg(FoldFloat const &val)
+   {
+      Core::Integ res = val.man;
+
+      if(val.exp < 0)
+         res >>= static_cast<Core::FastU>(-val.exp);
+      else
+         res <<= static_cast<Core::FastU>(val.exp);
+
+      return val.sig ? Core::Integ(-res) : res;
+   }
+
+   //
+   // FoldIntegToFloat
+   //
+   static FoldFloat FoldIntegToFloat(Core::Integ const &val)
+   {
+      return {abs(val), 0, val < 0};
+   }
+
+   //
+   // FoldSigned
+   //
+   // Converts an unsigned representation to signed.
+   //
+   static Core::Integ FoldSigned(Core::Integ val, Core::FastU bits)
+   {
+      if(mpz_tstbit(val.get_mpz_t(), bits - 1))
+         val -= FoldMask(bits) + 1;
+
+      return val;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::foldStmnt
+   //
+   // If the statement's operands are all literals, replaces it with a Move
+   // of its result. Returns true if folded.
+   //
+   bool Info::foldStmnt()
+   {
+      if(!OptFold)
+         return false;
+
+      Core::FastU wordBytes = Target::GetWordBytes();
+
+      //
+      // getLit
+      //
+      // Gets the unsigned value of a literal operand.
+      //
+      auto getLit = [&](IR::Arg const &arg, Core::Integ &res)
+      {
+         if(arg.a != IR::ArgBase::Lit || arg.aLit.off || !arg.aLit.size ||
+            arg.aLit.size % wordBytes || !arg.aLit.value->isValue())
+            return false;
+
+         auto const &val = arg.aLit.value->getValue();
+         if(val.v != IR::ValueBase::Fixed && val.v != IR::ValueBase::Float)
+            return false;
+
+         res = 0;
+         for(auto w = arg.aLit.size / wordBytes; w--;)
+         {
+            res <<= 32;
+            res  += Core::NumberCast<Core::Integ>(
+               getWord(arg.aLit.value->pos, val, w));
+         }
+
+         return true;
+      };
+
+      //
+      // setLit
+      //
+      auto setLit = [&](Core::Integ &&res)
+      {
+         auto size = stmnt->args[0].getSize();
+         auto bits = size / wordBytes * 32;
+
+         res &= FoldMask(bits);
+
+         auto exp = IR::ExpCreate_Value(
+            IR::Value_Fixed(std::move(res), IR::Type_Fixed(bits, 0, false, false)),
+            stmnt->pos);
+
+         stmnt->code = IR::CodeBase::Move;
+         stmnt->args = {Core::Pack, std::move(stmnt->args[0]), IR::Arg_Lit(size, exp)};
+
+         return true;
+      };
+
+      Core::Integ l, r;
+      char        t = stmnt->code.type[0];
+
+      switch(stmnt->code.base)
+      {
+      case IR::CodeBase::Add:
+      case IR::CodeBase::Div:
+      case IR::CodeBase::Mod:
+      case IR::CodeBase::Mul:
+      case IR::CodeBase::Sub:
+         if(stmnt->args.size() != 3 || stmnt->args[0].getSize() % wordBytes ||
+            !getLit(stmnt->args[1], l) || !getLit(stmnt->args[2], r))
+            return false;
+         break;
+
+      case IR::CodeBase::ShL:
+      case IR::CodeBase::ShR:
+         if(stmnt->args.size() != 3 || stmnt->args[0].getSize() % wordBytes ||
+            !getLit(stmnt->args[1], l) || !getLit(stmnt->args[2], r))
+            return false;
+         break;
+
+      case IR::CodeBase::Tr:
+         if(stmnt->args.size() != 2 || stmnt->args[0].getSize() % wordBytes ||
+            !getLit(stmnt->args[1], l))
+            return false;
+         break;
+
+      default:
+         return false;
+      }
+
+      Core::FastU n    = stmnt->args[0].getSize() / wordBytes;
+      Core::FastU bits = n * 32;
+
+      if(!n)
+         return false;
+
+      // Integer operations.
+      if((t == 'I' || t == 'U') && stmnt->code.base != IR::CodeBase::Tr)
+      {
+         if(t == 'I')
+         {
+            l = FoldSigned(l, bits);
+            if(stmnt->code.base != IR::CodeBase::ShL &&
+               stmnt->code.base != IR::CodeBase::ShR)
+               r = FoldSigned(r, bits);
+         }
+
+         switch(stmnt->code.base)
+         {
+         case IR::CodeBase::Add: return setLit(l + r);
+         case IR::CodeBase::Mul: return setLit(l * r);
+         case IR::CodeBase::Sub: return setLit(l - r);
+
+         case IR::CodeBase::Div:
+            if(r == 0) return false;
+            mpz_tdiv_q(l.get_mpz_t(), l.get_mpz_t(), r.get_mpz_t());
+            return setLit(std::move(l));
+
+         case IR::CodeBase::Mod:
+            if(r == 0) return false;
+            mpz_tdiv_r(l.get_mpz_t(), l.get_mpz_t(), r.get_mpz_t());
+            return setLit(std::move(l));
+
+         case IR::CodeBase::ShL:
+            if(r >= Core::NumberCast<Core::Integ>(bits)) return false;
+            return setLit(l << Core::NumberCast<Core::FastU>(r));
+
+         case IR::CodeBase::ShR:
+            // Signed shift floors, like an arithmetic shift.
+            if(r >= Core::NumberCast<Core::Integ>(bits)) return false;
+            return setLit(l >> Core::NumberCast<Core::FastU>(r));
+
+         default:
+            return false;
+         }
+      }
+
+      // Floating operations.
+      if(t == 'F' && stmnt->code.base != IR::CodeBase::Tr)
+      {
+         auto fi = getFloatInfo(n, t);
+
+         FoldFloat lf, rf, res;
+
+         if(stmnt->code.base == IR::CodeBase::ShL ||
+            stmnt->code.base == IR::CodeBase::ShR ||
+            !FoldFloatGet(l, fi, lf) || !FoldFloatGet(r, fi, rf))
+            return false;
+
+         switch(stmnt->code.base)
+         {
+         case IR::CodeBase::Add:
+         case IR::CodeBase::Sub:
+            {
+               if(stmnt->code.base == IR::CodeBase::Sub)
+                  rf.sig = !rf.sig;
+
+               // The helpers align the smaller operand by shifting it right,
+               // dropping any bits shifted out. Only fold if there are none,
+               // so that the result is the same.
+               auto &sf = lf.exp < rf.exp ? lf : rf;
+               auto  sd = static_cast<Core::FastU>(std::max(lf.exp, rf.exp) - sf.exp);
+               if(mpz_scan1(sf.man.get_mpz_t(), 0) < sd)
+                  return false;
+
+               // Align exponents, then add exactly.
+               res.exp = std::min(lf.exp, rf.exp);
+               lf.man <<= static_cast<Core::FastU>(lf.exp - res.exp);
+               rf.man <<= static_cast<Core::FastU>(rf.exp - res.exp);
+
+               Core::Integ sum = (lf.sig ? -lf.man : lf.man) + (rf.sig ? -rf.man : rf.man);
+               res.man = abs(sum);
+               res.sig = sum < 0;
+            }
+            break;
+
+         case IR::CodeBase::Mul:
+            res.man = lf.man * rf.man;
+            res.exp = lf.exp + rf.exp;
+            res.sig = lf.sig != rf.sig;
+            break;
+
+         case IR::CodeBase::Div:
+            {
+               // Only the odd part of the divisor can make the result inexact.
+               auto tz = mpz_scan1(rf.man.get_mpz_t(), 0);
+               rf.man >>= tz;
+
+               if(!mpz_divisible_p(lf.man.get_mpz_t(), rf.man.get_mpz_t()))
+                  return false;
+
+               res.man = lf.man / rf.man;
+               res.exp = lf.exp - rf.exp - static_cast<Core::FastI>(tz);
+               res.sig = lf.sig != rf.sig;
+            }
+            break;
+
+         default:
+            return false;
+         }
+
+         if(!FoldFloatPut(std::move(res), fi, l))
+            return false;
+
+         return setLit(std::move(l));
+      }
+
+      // Conversions.
+      if(stmnt->code.base == IR::CodeBase::Tr)
+      {
+         char tDst = stmnt->code.type[0] ? stmnt->code.type[0] : 'U';
+         char tSrc = stmnt->code.type[1] ? stmnt->code.type[1] : tDst;
+
+         Core::FastU nSrc = stmnt->args[1].getSize() / wordBytes;
+
+         // Fixed to fixed.
+         if((tDst == 'I' || tDst == 'U') && (tSrc == 'I' || tSrc == 'U'))
+         {
+            if(tSrc == 'I')
+               l = FoldSigned(l, nSrc * 32);
+
+            return setLit(std::move(l));
+         }
+
+         // Fixed to floating.
+         if(tDst == 'F' && (tSrc == 'I' || tSrc == 'U'))
+         {
+            if(tSrc == 'I')
+               l = FoldSigned(l, nSrc * 32);
+
+            if(!FoldFloatPut(FoldIntegToFloat(l), getFloatInfo(n, tDst), l))
+               return false;
+
+            return setLit(std::move(l));
+         }
+
+         // Floating to fixed.
+         if((tDst == 'I' || tDst == 'U') && tSrc == 'F')
+         {
+            FoldFloat lf;
+            if(!FoldFloatGet(l, getFloatInfo(nSrc, tSrc), lf, true))
+               return false;
+
+            l = FoldFloatToInteg(lf);
+
+            // Out of range values saturate in the helper.
+            Core::Integ max = FoldMask(bits - (tDst == 'I'));
+            Core::Integ min = tDst == 'I' ? Core::Integ(-max - 1) : Core::Integ(0);
+            if(l > max || l < min)
+               return false;
+
+            return setLit(std::move(l));
+         }
+
+         // Floating to floating.
+         if(tDst == 'F' && tSrc == 'F' && n != nSrc)
+         {
+            FoldFloat lf;
+            if(!FoldFloatGet(l, getFloatInfo(nSrc, tSrc), lf) ||
+               !FoldFloatPut(std::move(lf), getFloatInfo(n, tDst), l))
+               return false;
+
+            return setLit(std::move(l));
+         }
+      }
+
+      return false;
+   }
+}
+
+// EOF
+
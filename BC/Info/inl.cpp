@@ -0,0 +1,456 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Inlining of small leaf functions.
+//
+//-----------------------------------------------------------------------------
+
+#include "BC/Info.hpp"
+
+#include "BC/Flow.hpp"
+
+#include "Core/Option.hpp"
+
+#include "IR/Exp/Glyph.hpp"
+#include "IR/Function.hpp"
+#include "IR/Program.hpp"
+
+#include "Option/Bool.hpp"
+#include "Option/Int.hpp"
+
+#include "Target/CallType.hpp"
+#include "Target/Info.hpp"
+
+#include <algorithm>
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC
+{
+   //
+   // --bc-inline
+   //
+   static Option::Bool OptInline
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-inline")
+         .setGroup("codegen")
+         .setDescS("Enables or disables inlining of small leaf functions.")
+         .setDescL("Enables or disables inlining of small leaf functions. "
+            "Calls are replaced by a copy of the callee, which saves the "
+            "cost of the call but usually makes the output larger.\n"
+            "\n"
+            "Default is off."),
+
+      false
+   };
+
+   //
+   // --bc-inline-size
+   //
+   static Option::Int<std::size_t> OptInlineSize
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-inline-size")
+         .setGroup("codegen")
+         .setDescS("Sets the largest function to inline, in statements."),
+
+      6
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // GetInlCallee
+   //
+   static Core::String GetInlCallee(IR::Statement const *stmnt)
+   {
+      if(stmnt->code != IR::CodeBase::Call || stmnt->args.size() < 2 ||
+         stmnt->args[1].a != IR::ArgBase::Lit || stmnt->args[1].aLit.off)
+         return nullptr;
+
+      auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*stmnt->args[1].aLit.value);
+      return exp ? static_cast<Core::String>(exp->glyph) : nullptr;
+   }
+
+   //
+   // IsInlLabel
+   //
+   static bool IsInlLabel(IR::Function const &callee, Core::String glyph)
+   {
+      for(auto const &st : callee.block)
+         for(auto const &lab : st.labs)
+            if(lab == glyph) return true;
+
+      return false;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::BC
+{
+   //
+   // Info::inl
+   //
+   void Info::inl()
+   {
+      if(!OptInline)
+         return;
+
+      for(auto &itr : prog->rangeFunction())
+         inlFunc(itr);
+   }
+
+   //
+   // Info::inlFunc
+   //
+   void Info::inlFunc()
+   {
+      if(!func->defin)
+         return;
+
+      // Inlined registers go above the caller's, below its stack pointer.
+      Core::FastU stkPtr = FlowStkPtr(*func);
+      Core::FastU base   = std::max(func->localReg - stkPtr, func->param);
+      Core::FastU regs   = 0;
+      std::size_t count  = 0;
+
+      for(auto itr = func->block.begin(), end = func->block.end(); itr != end;)
+      {
+         stmnt = &*itr++;
+
+         auto glyph = GetInlCallee(stmnt);
+         if(!glyph) continue;
+
+         auto callee = prog->findFunction(glyph);
+         if(!callee || callee == func || !inlCallee(*callee))
+            continue;
+
+         auto prefix = func->glyph + ("$I" + std::to_string(count) + "$").c_str();
+         if(!inlStmnt(*callee, base, prefix))
+            continue;
+
+         // A leaf cannot start a longjmp, so there is none to propagate.
+         // Any labels, such as the inlined body's end, move to the next
+         // statement.
+         if(itr->code == IR::CodeBase::Jfar_Pro && (itr->labs.empty() || itr->next != &*end))
+         {
+            auto pro = &*itr++;
+            if(itr != end) itr->labs += pro->labs;
+            delete pro;
+         }
+
+         regs = std::max(regs, std::max(callee->localReg, callee->param));
+         ++count;
+      }
+
+      stmnt = nullptr;
+
+      if(count)
+         func->localReg = std::max(func->localReg, base + regs + stkPtr);
+   }
+
+   //
+   // Info::inlArg
+   //
+   // Returns true if arg can be moved into another function.
+   //
+   bool Info::inlArg(IR::Arg const &arg)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Cpy:
+      case IR::ArgBase::LocArr:
+      case IR::ArgBase::Vaa:
+         return false;
+
+      case IR::ArgBase::LocReg:
+      {
+         Core::FastU addr;
+         return getLocRegAddr(arg.aLocReg, addr);
+      }
+
+      case IR::ArgBase::Aut:    return inlArg(*arg.aAut.idx);
+      case IR::ArgBase::Far:    return inlArg(*arg.aFar.idx);
+      case IR::ArgBase::Gen:    return inlArg(*arg.aGen.idx);
+      case IR::ArgBase::GblArs: return inlArg(*arg.aGblArs.idx);
+      case IR::ArgBase::GblReg: return inlArg(*arg.aGblReg.idx);
+      case IR::ArgBase::HubArs: return inlArg(*arg.aHubArs.idx);
+      case IR::ArgBase::HubReg: return inlArg(*arg.aHubReg.idx);
+      case IR::ArgBase::ModArs: return inlArg(*arg.aModArs.idx);
+      case IR::ArgBase::ModReg: return inlArg(*arg.aModReg.idx);
+      case IR::ArgBase::Sta:    return inlArg(*arg.aSta.idx);
+      case IR::ArgBase::StrArs: return inlArg(*arg.aStrArs.idx);
+
+      case IR::ArgBase::GblArr: return inlArg(*arg.aGblArr.arr) && inlArg(*arg.aGblArr.idx);
+      case IR::ArgBase::HubArr: return inlArg(*arg.aHubArr.arr) && inlArg(*arg.aHubArr.idx);
+      case IR::ArgBase::ModArr: return inlArg(*arg.aModArr.arr) && inlArg(*arg.aModArr.idx);
+      case IR::ArgBase::StrArr: return inlArg(*arg.aStrArr.arr) && inlArg(*arg.aStrArr.idx);
+
+      default:
+         return true;
+      }
+   }
+
+   //
+   // Info::inlArg
+   //
+   // Moves arg from callee's registers and labels into the caller's.
+   //
+   void Info::inlArg(IR::Arg &arg, Core::FastU base, Core::String prefix,
+      IR::Function const &callee)
+   {
+      switch(arg.a)
+      {
+      case IR::ArgBase::Lit:
+         if(auto exp = dynamic_cast<IR::Exp_Glyph const *>(&*arg.aLit.value))
+         {
+            Core::String glyph = exp->glyph;
+            if(IsInlLabel(callee, glyph))
+            {
+               arg.aLit.value = IR::ExpCreate_Glyph(
+                  IR::Glyph(prog, prefix + glyph), exp->pos);
+            }
+         }
+         break;
+
+      case IR::ArgBase::LocReg:
+      {
+         Core::FastU addr;
+         getLocRegAddr(arg.aLocReg, addr);
+
+         auto &idx = arg.aLocReg.idx->aLit;
+         idx = IR::Arg_Lit(idx.size, func->block.getExp(
+            base * Target::GetWordBytes() + addr));
+         arg.aLocReg.off = 0;
+      }
+         break;
+
+      case IR::ArgBase::Aut:    inlArg(*arg.aAut.idx,    base, prefix, callee); break;
+      case IR::ArgBase::Far:    inlArg(*arg.aFar.idx,    base, prefix, callee); break;
+      case IR::ArgBase::Gen:    inlArg(*arg.aGen.idx,    base, prefix, callee); break;
+      case IR::ArgBase::GblArs: inlArg(*arg.aGblArs.idx, base, prefix, callee); break;
+      case IR::ArgBase::GblReg: inlArg(*arg.aGblReg.idx, base, prefix, callee); break;
+      case IR::ArgBase::HubArs: inlArg(*arg.aHubArs.idx, base, prefix, callee); break;
+      case IR::ArgBase::HubReg: inlArg(*arg.aHubReg.idx, base, prefix, callee); break;
+      case IR::ArgBase::ModArs: inlArg(*arg.aModArs.idx, base, prefix, callee); break;
+      case IR::ArgBase::ModReg: inlArg(*arg.aModReg.idx, base, prefix, callee); break;
+      case IR::ArgBase::Sta:    inlArg(*arg.aSta.idx,    base, prefix, callee); break;
+      case IR::ArgBase::StrArs: inlArg(*arg.aStrArs.idx, base, prefix, callee); break;
+
+      case IR::ArgBase::GblArr:
+         inlArg(*arg.aGblArr.arr, base, prefix, callee);
+         inlArg(*arg.aGblArr.idx, base, prefix, callee);
+         break;
+      case IR::ArgBase::HubArr:
+         inlArg(*arg.aHubArr.arr, base, prefix, callee);
+         inlArg(*arg.aHubArr.idx, base, prefix, callee);
+         break;
+      case IR::ArgBase::ModArr:
+         inlArg(*arg.aModArr.arr, base, prefix, callee);
+         inlArg(*arg.aModArr.idx, base, prefix, callee);
+         break;
+      case IR::ArgBase::StrArr:
+         inlArg(*arg.aStrArr.arr, base, prefix, callee);
+         inlArg(*arg.aStrArr.idx, base, prefix, callee);
+         break;
+
+      default:
+         break;
+      }
+   }
+
+   //
+   // Info::inlCallee
+   //
+   // Returns true if callee is small enough and simple enough to inline.
+   //
+   bool Info::inlCallee(IR::Function const &callee)
+   {
+      if(!callee.defin || callee.allocAut || callee.localAut ||
+         !callee.localArr.empty() || callee.block.empty())
+         return false;
+
+      if(callee.ctype != IR::CallType::StdCall && callee.ctype != IR::CallType::StkCall)
+         return false;
+
+      std::size_t size = 0;
+      for(auto const &st : callee.block)
+      {
+         if(++size > OptInlineSize)
+            return false;
+
+         switch(st.code.base)
+         {
+         // Must be a leaf.
+         case IR::CodeBase::Call:
+         case IR::CodeBase::Casm:
+         case IR::CodeBase::Cnat:
+         case IR::CodeBase::Cscr_IA:
+         case IR::CodeBase::Cscr_IS:
+         case IR::CodeBase::Cscr_SA:
+         case IR::CodeBase::Cscr_SS:
+         case IR::CodeBase::Cspe:
+         case IR::CodeBase::Jdyn:
+         case IR::CodeBase::Jfar_Pro:
+         case IR::CodeBase::Jfar_Set:
+         case IR::CodeBase::Jfar_Sta:
+         case IR::CodeBase::Pltn:
+         case IR::CodeBase::Rjnk:
+         case IR::CodeBase::Xcod_SID:
+            return false;
+
+         case IR::CodeBase::Retn:
+            if(st.args.size() > 1)
+               return false;
+            break;
+
+         default:
+            break;
+         }
+
+         for(auto const &arg : st.args)
+            if(!inlArg(arg)) return false;
+      }
+
+      return true;
+   }
+
+   //
+   // Info::inlStmnt
+   //
+   // Replaces the call at stmnt with the body of callee.
+   //
+   bool Info::inlStmnt(IR::Function const &callee, Core::FastU base,
+      Core::String prefix)
+   {
+      auto &dst = stmnt->args[0];
+
+      if(dst.a != IR::ArgBase::Stk && dst.a != IR::ArgBase::Nul)
+         return false;
+
+      if(stmnt->next == &*func->block.end())
+         return false;
+
+      // Arguments must exactly fill the parameter registers.
+      Core::FastU wordBytes = Target::GetWordBytes();
+      Core::FastU argSize   = 0;
+      for(auto arg = stmnt->args.begin() + 2, end = stmnt->args.end(); arg != end; ++arg)
+      {
+         if(arg->a != IR::ArgBase::Stk)
+            return false;
+
+         argSize += arg->aStk.size;
+      }
+
+      if(argSize != callee.param * wordBytes)
+         return false;
+
+      // Return values must match the call's destination.
+      for(auto const &st : callee.block)
+      {
+         if(st.code != IR::CodeBase::Retn)
+            continue;
+
+         if(st.args.empty() ? dst.getSize() != 0 : st.args[0].getSize() != dst.getSize())
+            return false;
+      }
+
+      auto &body  = func->block;
+      auto  call  = stmnt;
+      auto  next  = stmnt->next;
+      auto  idxSz = wordBytes;
+
+      body.setOrigin(call->pos);
+      body.addLabel(std::move(call->labs));
+
+      //
+      // getReg
+      //
+      auto getReg = [&](Core::FastU size, Core::FastU addr)
+      {
+         return IR::Arg_LocReg(size, IR::Arg_Lit(idxSz,
+            body.getExp(base * wordBytes + addr)));
+      };
+
+      // Pop arguments into parameter registers, last first.
+      for(auto arg = stmnt->args.end(), beg = stmnt->args.begin() + 2; arg != beg;)
+      {
+         --arg;
+         argSize -= arg->aStk.size;
+         body.addStmnt(call, IR::CodeBase::Move,
+            getReg(arg->aStk.size, argSize), IR::Arg_Stk(arg->aStk.size));
+      }
+
+      // Copy callee body.
+      auto end = prefix + "end";
+      bool jumpEnd = false;
+
+      for(auto const &st : callee.block)
+      {
+         body.setOrigin(st.pos);
+
+         for(auto const &lab : st.labs)
+            body.addLabel(prefix + lab);
+
+         if(st.code == IR::CodeBase::Retn)
+         {
+            if(!st.args.empty() &&
+               !(st.args[0].a == IR::ArgBase::Stk && dst.a == IR::ArgBase::Stk))
+            {
+               IR::Arg src = st.args[0];
+               inlArg(src, base, prefix, callee);
+               body.addStmnt(call, IR::CodeBase::Move, dst, std::move(src));
+            }
+
+            // The last statement can fall through.
+            if(st.next != &*callee.block.end())
+            {
+               body.addStmnt(call, IR::CodeBase::Jump, IR::Arg_Lit(idxSz,
+                  body.getExp(IR::Glyph(prog, end))));
+               jumpEnd = true;
+            }
+
+            continue;
+         }
+
+         Core::Array<IR::Arg> args{st.args};
+         for(auto &arg : args)
+            inlArg(arg, base, prefix, callee);
+
+         body.addStmntArgs(call, st.code, std::move(args));
+      }
+
+      // Any labels left pending belong to the statement after the call.
+      if(body.hasLabelPending())
+         body.addStmnt(call, IR::CodeBase::Nop);
+
+      if(jumpEnd)
+         next->labs += Core::Array<Core::String>{Core::Pack, end};
+
+      delete call;
+      return true;
+   }
+}
+
+// EOF
+
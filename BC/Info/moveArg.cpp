@@ -43,10 +43,13 @@ namespace GDCC::BC
    // Info::moveArgStk_src
    //
    // If idx is not Stk, makes it one by adding a new Move_W statement.
+   // Returns true if it did, in which case stmnt is rewound so that the
+   // block loop continues at the new statement. The caller must return
+   // without further use of stmnt.
    //
-   void Info::moveArgStk_src(IR::Arg &idx)
+   bool Info::moveArgStk_src(IR::Arg &idx)
    {
-      if(idx.a == IR::ArgBase::Stk) return;
+      if(idx.a == IR::ArgBase::Stk) return false;
 
       auto size = idx.getSize();
 
@@ -57,9 +60,9 @@ namespace GDCC::BC
       idx = IR::Arg_Stk(size);
 
       // Reset iterator for further translation.
-      stmnt = stmnt->prev;
+      stmnt = stmnt->prev->prev;
 
-      throw ResetStmnt();
+      return true;
    }
 }
 
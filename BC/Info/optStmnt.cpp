@@ -57,6 +57,9 @@ namespace GDCC::BC
       if(!OptPass)
          return;
 
+      if(foldStmnt())
+         return;
+
       optStmnt_Cspe_Drop();
       optStmnt_JumpNext();
       optStmnt_LNot_Jcnd();
@@ -26,40 +26,43 @@ namespace GDCC::BC
    //
    // Info::trStmntStk2
    //
-   void Info::trStmntStk2()
+   // Returns true if stmnt was reset.
+   //
+   bool Info::trStmntStk2()
    {
       moveArgStk_dst(stmnt->args[0]);
-      moveArgStk_src(stmnt->args[1]);
+      return moveArgStk_src(stmnt->args[1]);
    }
 
    //
    // Info::trStmntStk3
    //
-   void Info::trStmntStk3(bool ordered)
+   // Returns true if stmnt was reset.
+   //
+   bool Info::trStmntStk3(bool ordered)
    {
       moveArgStk_dst(stmnt->args[0]);
 
-      auto size = stmnt->args[1].getSize();
+      auto st   = stmnt;
+      auto size = st->args[1].getSize();
 
-      try
-      {
-         moveArgStk_src(stmnt->args[1]);
-      }
-      catch(ResetStmnt const &)
+      if(moveArgStk_src(st->args[1]))
       {
-         if(ordered && stmnt->next->args[2].a == IR::ArgBase::Stk)
-            block->addStmnt(stmnt->next, IR::CodeBase::Swap,
+         if(ordered && st->args[2].a == IR::ArgBase::Stk)
+            block->addStmnt(st, IR::CodeBase::Swap,
                IR::Arg_Stk(size), IR::Arg_Stk(size));
 
-         throw;
+         return true;
       }
 
-      moveArgStk_src(stmnt->args[2]);
+      return moveArgStk_src(st->args[2]);
    }
 
    //
    // Info::trStmntShift
    //
+   // Returns true if the shift is by a literal that was left in place.
+   //
    bool Info::trStmntShift(bool moveLit)
    {
       if(stmnt->args[1].a != IR::ArgBase::Stk &&
@@ -67,7 +70,8 @@ namespace GDCC::BC
          Core::Error(stmnt->pos, "trStmntShift disorder");
 
       moveArgStk_dst(stmnt->args[0]);
-      moveArgStk_src(stmnt->args[1]);
+      if(moveArgStk_src(stmnt->args[1]))
+         return false;
 
       if(!moveLit && stmnt->args[2].a == IR::ArgBase::Lit)
          return true;
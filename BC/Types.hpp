@@ -24,6 +24,13 @@ namespace GDCC::BC
 {
    class FixedInfo;
    class FloatInfo;
+   class FlowArg;
+   class FlowBlock;
+   class FlowFunc;
+   class FlowGraph;
+   class FlowRange;
+   class FlowSet;
+   class FlowStmnt;
    class Info;
 
    typedef Info InfoBase;
@@ -19,6 +19,7 @@
 #include "IR/Program.hpp"
 
 #include "Option/Bool.hpp"
+#include "Option/CStr.hpp"
 #include "Option/Exception.hpp"
 #include "Option/Int.hpp"
 
@@ -266,6 +267,21 @@ namespace GDCC::BC::ZDACS
       4
    };
 
+   //
+   // --bc-zdacs-size-report
+   //
+   Option::CStr Info::SizeReport
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-size-report")
+         .setGroup("output")
+         .setDescS("Writes a report of CODE chunk size to a file.")
+         .setDescL("Writes a report of CODE chunk size to a file. Use - to "
+            "write to stdout. Bytes are broken down by function, by IR "
+            "instruction, and by source line, with arithmetic helper "
+            "functions and the init script totalled separately.")
+   };
+
    //
    // --bc-zdacs-stkcall-retn
    //
@@ -308,6 +324,8 @@ namespace GDCC::BC::ZDACS
       codeInit   {0},
       codeInitEnd{0},
 
+      initTabSpace{nullptr},
+
       numChunkAIMP{0},
       numChunkAINI{0},
       numChunkARAY{0},
@@ -326,7 +344,9 @@ namespace GDCC::BC::ZDACS
       numChunkSNAM{0},
       numChunkSPTR{0},
       numChunkSTRL{0},
-      numChunkSVCT{0}
+      numChunkSVCT{0},
+
+      sizeIniti{0}
    {
    }
 
@@ -1051,6 +1071,39 @@ namespace GDCC::BC::ZDACS
       return 24;
    }
 
+   //
+   // Info::GetInitRunSize
+   //
+   Core::FastU Info::GetInitRunSize(InitRun const &run)
+   {
+      switch(run.op)
+      {
+      case InitOp::Word:
+         switch(run.val.tag)
+         {
+         case InitTag::Empty: return 0;
+         case InitTag::Fixed: return run.val.val ? 24 : 0;
+         case InitTag::Funct: return 24;
+         case InitTag::StrEn: return 28;
+         }
+         break;
+
+         // push_lit
+         // push_lit sub copy push_lit drop_arr
+         // copy push_lit cmp_ne cjmp_tru
+         // drop_nul
+      case InitOp::Fill: return 68;
+
+         // push_lit
+         // push_lit sub copy copy push_lit sub push_arr drop_arr
+         // copy push_lit cmp_ne cjmp_tru
+         // drop_nul
+      case InitOp::Copy: return 84;
+      }
+
+      return 0;
+   }
+
    //
    // Info:GetParamMax
    //
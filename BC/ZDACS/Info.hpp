@@ -28,12 +28,15 @@
 #include "../../IR/Code.hpp"
 
 #include "../../Option/Bool.hpp"
+#include "../../Option/CStr.hpp"
 #include "../../Option/IntMap.hpp"
 
 #include "../../Target/Addr.hpp"
 #include "../../Target/CallType.hpp"
 
+#include <map>
 #include <unordered_map>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -66,6 +69,8 @@ namespace GDCC::BC::ZDACS
       static ScriptTypeMap ScriptFlags;
       static ScriptTypeMap ScriptTypes;
 
+      static Option::CStr SizeReport;
+
       static Option::Int<Core::FastU> StaArray;
 
       static Option::Bool UseChunkSTRE;
@@ -95,6 +100,41 @@ namespace GDCC::BC::ZDACS
          InitTag     tag;
       };
 
+      //
+      // InitOp
+      //
+      enum class InitOp
+      {
+         Word, // Store val at idx.
+         Fill, // Loop storing val at [idx, idx + len).
+         Copy, // Loop copying from initTab at val to [idx, idx + len).
+      };
+
+      //
+      // InitRun
+      //
+      class InitRun
+      {
+      public:
+         Core::FastU idx;
+         Core::FastU len;
+         Core::FastU code; // Loop address.
+         InitVal     val;
+         InitOp      op;
+      };
+
+      //
+      // SizeCount
+      //
+      class SizeCount
+      {
+      public:
+         SizeCount() : bytes{0}, count{0} {}
+
+         Core::FastU bytes;
+         Core::FastU count;
+      };
+
       //
       // InitData
       //
@@ -103,7 +143,9 @@ namespace GDCC::BC::ZDACS
       public:
          InitData() : max{0}, needTag{false}, onlyNil{true}, onlyStr{true} {}
 
-         std::unordered_map<Core::FastU, InitVal> vals;
+         std::map<Core::FastU, InitVal> vals;
+
+         std::vector<InitRun> runs;
 
          Core::FastU max;
 
@@ -164,6 +206,7 @@ namespace GDCC::BC::ZDACS
 
       void genIniti();
       void genInitiSpace(IR::Space &space);
+      void genInitiTable();
 
       virtual void genObj();
 
@@ -504,6 +547,9 @@ namespace GDCC::BC::ZDACS
 
       void putIniti();
       void putInitiSpace(IR::Space &space, Code code);
+      void putInitiSpace(IR::Space &space, Code code, InitRun const &run);
+
+      void putSizeReport(std::ostream &out);
 
       virtual void putStmnt();
       void putStmnt_Add();
@@ -762,6 +808,9 @@ namespace GDCC::BC::ZDACS
 
       std::unordered_map<IR::Space const *, InitData> init;
 
+      std::vector<Core::FastU> initTab;
+      IR::Space               *initTabSpace;
+
       Core::FastU numChunkAIMP;
       Core::FastU numChunkAINI;
       Core::FastU numChunkARAY;
@@ -782,11 +831,19 @@ namespace GDCC::BC::ZDACS
       Core::FastU numChunkSTRL;
       Core::FastU numChunkSVCT;
 
+      // Bytes of CODE generated, for --bc-zdacs-size-report.
+      std::unordered_map<IR::CodeBase, SizeCount>               sizeCode;
+      std::unordered_map<IR::Function const *, Core::FastU>     sizeFunc;
+      std::map<std::pair<Core::String, std::size_t>, SizeCount> sizeOrigin;
+      Core::FastU                                               sizeIniti;
+
       std::unordered_map<IR::Space const *, bool> spaceUsed;
 
 
       static Core::FastU CodeBase();
 
+      static Core::FastU GetInitRunSize(InitRun const &run);
+
       static Core::FastU GetParamMax(IR::CallType call);
 
       static Core::FastU GetRetnMax(IR::CallType call);
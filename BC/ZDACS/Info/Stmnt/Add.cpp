@@ -327,7 +327,7 @@ namespace GDCC::BC::ZDACS
       auto n = getStmntSize();
 
       if(n != 1)
-         return trStmntStk3(false);
+         return (void)trStmntStk3(false);
 
       if(stmnt->args[0] == stmnt->args[1]) switch(stmnt->args[0].a)
       {
@@ -393,7 +393,7 @@ namespace GDCC::BC::ZDACS
       auto n = getStmntSize();
 
       if(n != 1)
-         return trStmntStk3(true);
+         return (void)trStmntStk3(true);
 
       if(stmnt->args[0] == stmnt->args[1]) switch(stmnt->args[0].a)
       {
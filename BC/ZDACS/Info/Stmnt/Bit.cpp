@@ -546,7 +546,8 @@ namespace GDCC::BC::ZDACS
       }
       else
       {
-         trStmntStk3(false);
+         if(trStmntStk3(false))
+            return;
 
          if(n > 1)
             func->setLocalTmp(n * 2 - 1);
@@ -595,7 +596,8 @@ namespace GDCC::BC::ZDACS
       }
       else
       {
-         trStmntStk2();
+         if(trStmntStk2())
+            return;
 
          func->setLocalTmp(1);
       }
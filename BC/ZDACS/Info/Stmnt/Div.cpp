@@ -415,7 +415,7 @@ namespace GDCC::BC::ZDACS
       auto n = getStmntSize();
 
       if(n != 1)
-         return trStmntStk3(true);
+         return (void)trStmntStk3(true);
 
       if(isPushArg(stmnt->args[1]) && isPushArg(stmnt->args[2]))
       {
@@ -126,11 +126,13 @@ namespace GDCC::BC::ZDACS
          return;
 
       if(n == 1)
-         return trStmntStk3(false);
+         return (void)trStmntStk3(false);
 
       if(!isPushArg(stmnt->args[1]) || !isPushArg(stmnt->args[2]))
       {
-         trStmntStk3(false);
+         if(trStmntStk3(false))
+            return;
+
          trStmntTmp(1);
       }
       else
@@ -516,7 +516,8 @@ namespace GDCC::BC::ZDACS
          IR::ErrorCode(stmnt, "disorder");
 
       moveArgStk_dst(stmnt->args[0]);
-      moveArgStk_src(stmnt->args[1]);
+      if(moveArgStk_src(stmnt->args[1]))
+         return;
 
       if(!isPushArg(stmnt->args[2]) || !isFastArg(stmnt->args[2]))
       {
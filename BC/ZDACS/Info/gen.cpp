@@ -78,6 +78,8 @@ namespace GDCC::BC::ZDACS
          return false;
       };
 
+      auto codeBegin = numChunkCODE;
+
       // Back label glyph.
       backGlyphWord(func->label, CodeBase() + numChunkCODE);
 
@@ -91,6 +93,9 @@ namespace GDCC::BC::ZDACS
 
       genBlock(func->block);
 
+      if(SizeReport.data() && numChunkCODE != codeBegin)
+         sizeFunc[func] = numChunkCODE - codeBegin;
+
       switch(func->ctype)
       {
       case IR::CallType::StdCall:
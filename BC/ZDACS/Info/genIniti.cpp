@@ -16,11 +16,54 @@
 
 #include "IR/Program.hpp"
 
+#include "Option/Bool.hpp"
+
 #include "Target/Info.hpp"
 
 #include <sstream>
 
 
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::BC::ZDACS
+{
+   //
+   // --bc-zdacs-init-fill
+   //
+   static Option::Bool InitFill
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-init-fill")
+         .setGroup("codegen")
+         .setDescS("Initializes runs of equal words with a loop.")
+         .setDescL(
+            "Initializes runs of equal words in global and world arrays "
+            "with a loop instead of a store for each word. Default is on."),
+
+      true
+   };
+
+   //
+   // --bc-zdacs-init-table
+   //
+   static Option::Bool InitTable
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("bc-zdacs-init-table")
+         .setGroup("codegen")
+         .setDescS("Initializes large tables by copying from a module array.")
+         .setDescL(
+            "Initializes large tables in global and world arrays by copying "
+            "from a module array whose contents are stored in the AINI "
+            "chunk. Default is on."),
+
+      true
+   };
+}
+
+
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
 //
@@ -116,9 +159,14 @@ namespace GDCC::BC::ZDACS
       // Save index for initializer end.
       codeInitEnd = CodeBase() + numChunkCODE;
 
+      // Allocate module array for copied tables.
+      genInitiTable();
+
       // Terminate script.
       // term
       numChunkCODE += 4;
+
+      sizeIniti = CodeBase() + numChunkCODE - codeInit;
    }
 
    //
@@ -126,21 +174,118 @@ namespace GDCC::BC::ZDACS
    //
    void Info::genInitiSpace(IR::Space &space_)
    {
-      auto const &ini = init[&space_];
+      auto &ini = init[&space_];
+
+      // Initializers are already ordered by index.
+      std::vector<std::pair<Core::FastU, InitVal>> vals;
+      vals.reserve(ini.vals.size());
+      for(auto const &val : ini.vals)
+         if(val.second.tag != InitTag::Empty) vals.push_back(val);
+
+      std::vector<InitRun> runs;
+
+      //
+      // isFixed
+      //
+      auto isFixed = [&](std::size_t i)
+         {return vals[i].second.tag == InitTag::Fixed;};
+
+      for(std::size_t i = 0, e = vals.size(); i != e;)
+      {
+         if(!isFixed(i))
+         {
+            runs.push_back({vals[i].first, 1, 0, vals[i].second, InitOp::Word});
+            ++i;
+            continue;
+         }
+
+         // Find span of consecutive fixed words.
+         std::size_t spanEnd = i + 1;
+         while(spanEnd != e && isFixed(spanEnd) &&
+            vals[spanEnd].first == vals[spanEnd - 1].first + 1)
+            ++spanEnd;
+
+         // Split span into fills and single stores.
+         std::size_t runsBeg  = runs.size();
+         Core::FastU runsSize = 0;
+         for(std::size_t j = i; j != spanEnd;)
+         {
+            std::size_t k = j + 1;
+            while(k != spanEnd && vals[k].second.val == vals[j].second.val)
+               ++k;
+
+            // Zeroes are skipped.
+            if(vals[j].second.val)
+            {
+               if(InitFill && k - j >= 3)
+                  runs.push_back({vals[j].first, k - j, 0, vals[j].second, InitOp::Fill});
+               else for(auto l = j; l != k; ++l)
+                  runs.push_back({vals[l].first, 1, 0, vals[l].second, InitOp::Word});
+            }
+
+            j = k;
+         }
+
+         for(auto r = runs.begin() + runsBeg; r != runs.end(); ++r)
+            runsSize += GetInitRunSize(*r);
+
+         // If smaller, copy the whole span from the table instead.
+         InitRun copy{vals[i].first, spanEnd - i, 0, {}, InitOp::Copy};
+         if(InitTable && GetInitRunSize(copy) + copy.len * 4 < runsSize)
+         {
+            runs.resize(runsBeg);
+
+            copy.val.tag = InitTag::Fixed;
+            copy.val.val = initTab.size();
+            for(auto j = i; j != spanEnd; ++j)
+               initTab.push_back(vals[j].second.val);
+
+            runs.push_back(copy);
+         }
+
+         i = spanEnd;
+      }
 
       // Count instructions needed for initializers.
-      for(auto const &val : ini.vals) switch(val.second.tag)
+      for(auto &run : runs)
       {
-      case InitTag::Empty: break;
+         // Loops start after pushing the end index.
+         run.code = CodeBase() + numChunkCODE + 8;
 
-      case InitTag::Fixed:
-         if(val.second.val)
-            numChunkCODE += 24;
-         break;
+         numChunkCODE += GetInitRunSize(run);
+      }
 
-      case InitTag::Funct: numChunkCODE += 24; break;
-      case InitTag::StrEn: numChunkCODE += 28; break;
+      ini.runs = std::move(runs);
+   }
+
+   //
+   // Info::genInitiTable
+   //
+   void Info::genInitiTable()
+   {
+      if(initTab.empty())
+         return;
+
+      auto &sp = prog->getSpaceModArr("___GDCC__InitTab");
+      sp.alloc = true;
+      sp.defin = true;
+      sp.words = initTab.size();
+
+      auto &ini = init[&sp];
+      for(Core::FastU i = 0, e = initTab.size(); i != e; ++i)
+      {
+         auto &iv = ini.vals[i];
+         iv.tag = InitTag::Fixed;
+         iv.val = initTab[i];
       }
+
+      ini.max     = initTab.size();
+      ini.onlyNil = false;
+      ++numChunkAINI;
+
+      InfoBase::genSpace(sp);
+
+      initTabSpace = &sp;
    }
 }
 
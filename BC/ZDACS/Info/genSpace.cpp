@@ -191,7 +191,20 @@ namespace GDCC::BC::ZDACS
       switch(val.v)
       {
       case IR::ValueBase::Array:
-         for(auto const &v : val.vArray.value)
+         if(!val.vArray.packed.empty())
+         {
+            bits = val.vArray.vtype.elemT->tFixed.getBits();
+            for(auto const &v : val.vArray.packed)
+            {
+               for(Core::FastU w = 0, e = (bits + 31) / 32; w != e; ++w)
+               {
+                  iv = &ini.vals.emplace_hint(ini.vals.end(), itr++, InitVal())->second;
+                  iv->tag = InitTag::Fixed;
+                  iv->val = (v >> w * 32) & 0xFFFFFFFF;
+               }
+            }
+         }
+         else for(auto const &v : val.vArray.value)
             genSpaceInitiValue(ini, itr, v);
          break;
 
@@ -43,6 +43,8 @@ namespace GDCC::BC::ZDACS
          }
       }
 
+      auto codeBegin = numChunkCODE;
+
       switch(stmnt->code.base)
       {
       case IR::CodeBase::Nop: numChunkCODE += 4; break;
@@ -105,6 +107,19 @@ namespace GDCC::BC::ZDACS
       default:
          IR::ErrorCode(stmnt, "unsupported gen");
       }
+
+      if(SizeReport.data())
+      {
+         auto size = numChunkCODE - codeBegin;
+
+         auto &code = sizeCode[stmnt->code.base];
+         code.bytes += size;
+         ++code.count;
+
+         auto &orig = sizeOrigin[{stmnt->pos.file, stmnt->pos.line}];
+         orig.bytes += size;
+         ++orig.count;
+      }
    }
 
    //
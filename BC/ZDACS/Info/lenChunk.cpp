@@ -100,10 +100,12 @@ namespace GDCC::BC::ZDACS
 
       Core::FastU len = 0;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr &&
-            itr.first->defin && !itr.second.onlyNil)
-            len += itr.second.max * 4 + 12;
+      for(auto const &sp : prog->rangeSpaceModArs())
+      {
+         auto itr = init.find(&sp);
+         if(sp.defin && itr != init.end() && !itr->second.onlyNil)
+            len += itr->second.max * 4 + 12;
+      }
 
       return len;
    }
@@ -137,11 +139,14 @@ namespace GDCC::BC::ZDACS
 
       Core::FastU len = 0;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr && itr.first->defin)
+      for(auto const &sp : prog->rangeSpaceModArs())
       {
-         if(itr.second.needTag && !itr.second.onlyStr)
-            len += itr.second.max + 13;
+         auto itr = init.find(&sp);
+         if(!sp.defin || itr == init.end())
+            continue;
+
+         if(itr->second.needTag && !itr->second.onlyStr)
+            len += itr->second.max + 13;
       }
 
       return len;
@@ -60,6 +60,9 @@ namespace GDCC::BC::ZDACS
    //
    void Info::preStmnt()
    {
+      if(foldStmnt())
+         return;
+
       switch(stmnt->code.base)
       {
       case IR::CodeBase::Add:   preStmnt_Add(); break;
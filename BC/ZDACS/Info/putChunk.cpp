@@ -140,19 +140,21 @@ namespace GDCC::BC::ZDACS
    {
       if(!numChunkAINI) return;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr &&
-            itr.first->defin && !itr.second.onlyNil)
+      for(auto const &sp : prog->rangeSpaceModArs())
       {
+         auto itr = init.find(&sp);
+         if(!sp.defin || itr == init.end() || itr->second.onlyNil)
+            continue;
+
          putData("AINI", 4);
-         putWord(itr.second.max * 4 + 4);
-         putWord(itr.first->value);
+         putWord(itr->second.max * 4 + 4);
+         putWord(sp.value);
 
-         for(Core::FastU i = 0, e = itr.second.max; i != e; ++i)
+         auto val = itr->second.vals.begin(), end = itr->second.vals.end();
+         for(Core::FastU i = 0, e = itr->second.max; i != e; ++i)
          {
-            auto val = itr.second.vals.find(i);
-            if(val != itr.second.vals.end())
-               putWord(val->second.val);
+            if(val != end && val->first == i)
+               putWord((val++)->second.val);
             else
                putWord(0);
          }
@@ -188,11 +190,14 @@ namespace GDCC::BC::ZDACS
       putData("ASTR", 4);
       putWord(numChunkASTR * 4);
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr && itr.first->defin)
+      for(auto const &sp : prog->rangeSpaceModArs())
       {
-         if(itr.second.needTag && itr.second.onlyStr)
-            putWord(itr.first->value);
+         auto itr = init.find(&sp);
+         if(!sp.defin || itr == init.end())
+            continue;
+
+         if(itr->second.needTag && itr->second.onlyStr)
+            putWord(sp.value);
       }
    }
 
@@ -203,21 +208,24 @@ namespace GDCC::BC::ZDACS
    {
       if(!numChunkATAG) return;
 
-      for(auto const &itr : init)
-         if(itr.first->space.base == IR::AddrBase::ModArr && itr.first->defin)
+      for(auto const &sp : prog->rangeSpaceModArs())
       {
-         if(!itr.second.needTag || itr.second.onlyStr) continue;
+         auto itr = init.find(&sp);
+         if(!sp.defin || itr == init.end())
+            continue;
+
+         if(!itr->second.needTag || itr->second.onlyStr) continue;
 
          putData("ATAG", 4);
-         putWord(itr.second.max + 5);
+         putWord(itr->second.max + 5);
 
          putByte(0); // version
-         putWord(itr.first->value);
+         putWord(sp.value);
 
-         for(Core::FastU i = 0, e = itr.second.max; i != e; ++i)
+         auto val = itr->second.vals.begin(), end = itr->second.vals.end();
+         for(Core::FastU i = 0, e = itr->second.max; i != e; ++i)
          {
-            auto val = itr.second.vals.find(i);
-            if(val != itr.second.vals.end()) switch(val->second.tag)
+            if(val != end && val->first == i) switch((val++)->second.tag)
             {
             case InitTag::Empty: putByte(0); break;
             case InitTag::Fixed: putByte(0); break;
@@ -18,6 +18,10 @@
 #include "IR/Linkage.hpp"
 #include "IR/Program.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
 
 //----------------------------------------------------------------------------|
 // Options                                                                    |
@@ -66,6 +70,103 @@ namespace GDCC::BC::ZDACS
             outStr << fn.glyph << ' ' << fn.linka << ' ' << fn.valueInt << '\n';
          }
       }
+
+      if(auto outName = SizeReport.data())
+      {
+         auto buf = Core::FileOpenStream(outName, std::ios_base::out);
+
+         std::ostream outStr{buf.get()};
+
+         putSizeReport(outStr);
+      }
+   }
+
+   //
+   // Info::putSizeReport
+   //
+   void Info::putSizeReport(std::ostream &outStr)
+   {
+      //
+      // putRow
+      //
+      auto putRow = [&](Core::FastU bytes, Core::FastU count)
+      {
+         outStr << std::setw(10) << bytes << ' '
+            << std::setw(5) << std::fixed << std::setprecision(1)
+            << (numChunkCODE ? bytes * 100.0 / numChunkCODE : 0.0) << "% ";
+
+         if(count) outStr << std::setw(8) << count << ' ';
+      };
+
+      //
+      // sorted
+      //
+      // Returns the entries of a size table, largest first. Equal sizes are
+      // ordered by key, so that the report does not depend on hashing.
+      //
+      auto sorted = [](auto const &table, auto getBytes, auto getKey)
+      {
+         std::vector<typename std::decay_t<decltype(table)>::value_type const *> vec;
+         vec.reserve(table.size());
+         for(auto const &itr : table) vec.push_back(&itr);
+
+         std::sort(vec.begin(), vec.end(), [&](auto l, auto r)
+         {
+            auto lb = getBytes(*l), rb = getBytes(*r);
+            return lb != rb ? lb > rb : getKey(*l) < getKey(*r);
+         });
+
+         return vec;
+      };
+
+      Core::FastU sizeAdded = 0, numAdded = 0, sizeFuncs = 0;
+
+      auto funcs = sorted(sizeFunc, [](auto const &itr) {return itr.second;},
+         [](auto const &itr) {return itr.first->glyph;});
+
+      for(auto const &itr : sizeFunc)
+      {
+         if(funcAdded.count(itr.first->glyph))
+            sizeAdded += itr.second, ++numAdded;
+         else
+            sizeFuncs += itr.second;
+      }
+
+      // Summary.
+      outStr << "CODE chunk: " << numChunkCODE << " bytes\n";
+      putRow(sizeFuncs, 0); outStr << "functions (" << funcs.size() - numAdded << ")\n";
+      putRow(sizeAdded, 0); outStr << "arithmetic helpers (" << numAdded << ")\n";
+      putRow(sizeIniti, 0); outStr << "init script\n";
+      putRow(numChunkCODE - sizeFuncs - sizeAdded - sizeIniti, 0);
+      outStr << "other\n";
+
+      // By function.
+      outStr << "\nBytes by function:\n";
+      for(auto itr : funcs)
+      {
+         putRow(itr->second, 0);
+         outStr << itr->first->glyph;
+         if(funcAdded.count(itr->first->glyph)) outStr << " (helper)";
+         outStr << '\n';
+      }
+
+      // By instruction.
+      outStr << "\nBytes by instruction:\n";
+      for(auto itr : sorted(sizeCode, [](auto const &i) {return i.second.bytes;},
+         [](auto const &i) {return i.first;}))
+      {
+         putRow(itr->second.bytes, itr->second.count);
+         outStr << itr->first << '\n';
+      }
+
+      // By origin.
+      outStr << "\nBytes by origin:\n";
+      for(auto itr : sorted(sizeOrigin, [](auto const &i) {return i.second.bytes;},
+         [](auto const &i) {return i.first;}))
+      {
+         putRow(itr->second.bytes, itr->second.count);
+         outStr << itr->first.first << ':' << itr->first.second << '\n';
+      }
    }
 }
 
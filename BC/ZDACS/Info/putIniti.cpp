@@ -102,39 +102,90 @@ namespace GDCC::BC::ZDACS
    //
    void Info::putInitiSpace(IR::Space &space_, Code code)
    {
-      auto const &ini = init[&space_];
-
       // Write instructions needed for initializers.
-      for(auto const &val : ini.vals) switch(val.second.tag)
+      for(auto const &run : init[&space_].runs)
+         putInitiSpace(space_, code, run);
+   }
+
+   //
+   // Info::putInitiSpace
+   //
+   void Info::putInitiSpace(IR::Space &space_, Code code, InitRun const &run)
+   {
+      switch(run.op)
       {
-      case InitTag::Empty: break;
+      case InitOp::Word:
+         switch(run.val.tag)
+         {
+         case InitTag::Empty: break;
+
+         case InitTag::Fixed:
+            // Skip zeroes.
+            if(!run.val.val) break;
+
+            putCode(Code::Push_Lit);
+            putWord(run.idx);
+            putCode(Code::Push_Lit);
+            putWord(run.val.val);
+            putCode(code);
+            putWord(space_.value);
+            break;
+
+         case InitTag::Funct:
+            putCode(Code::Push_Lit);
+            putWord(run.idx);
+            putStmntPushFunct(run.val.val);
+            putCode(code);
+            putWord(space_.value);
+            break;
+
+         case InitTag::StrEn:
+            putCode(Code::Push_Lit);
+            putWord(run.idx);
+            putStmntPushStrEn(run.val.val);
+            putCode(code);
+            putWord(space_.value);
+            break;
+         }
+         break;
 
-      case InitTag::Fixed:
-         // Skip zeroes.
-         if(!val.second.val) break;
+      case InitOp::Fill:
+         // Loop from the end of the run, keeping the index on the stack.
+         putCode(Code::Push_Lit, run.idx + run.len);
 
-         putCode(Code::Push_Lit);
-         putWord(val.first);
-         putCode(Code::Push_Lit);
-         putWord(val.second.val);
-         putCode(code);
-         putWord(space_.value);
-         break;
+         putCode(Code::Push_Lit, 1);
+         putCode(Code::SubU);
+         putCode(Code::Copy);
+         putCode(Code::Push_Lit, run.val.val);
+         putCode(code, space_.value);
 
-      case InitTag::Funct:
-         putCode(Code::Push_Lit);
-         putWord(val.first);
-         putStmntPushFunct(val.second.val);
-         putCode(code);
-         putWord(space_.value);
+         putCode(Code::Copy);
+         putCode(Code::Push_Lit, run.idx);
+         putCode(Code::CmpU_NE);
+         putCode(Code::Jcnd_Tru, run.code);
+
+         putCode(Code::Drop_Nul);
          break;
 
-      case InitTag::StrEn:
-         putCode(Code::Push_Lit);
-         putWord(val.first);
-         putStmntPushStrEn(val.second.val);
-         putCode(code);
-         putWord(space_.value);
+      case InitOp::Copy:
+         // As with Fill, but reading from the table.
+         putCode(Code::Push_Lit, run.idx + run.len);
+
+         putCode(Code::Push_Lit, 1);
+         putCode(Code::SubU);
+         putCode(Code::Copy);
+         putCode(Code::Copy);
+         putCode(Code::Push_Lit, run.idx - run.val.val);
+         putCode(Code::SubU);
+         putCode(Code::Push_ModArr, initTabSpace->value);
+         putCode(code, space_.value);
+
+         putCode(Code::Copy);
+         putCode(Code::Push_Lit, run.idx);
+         putCode(Code::CmpU_NE);
+         putCode(Code::Jcnd_Tru, run.code);
+
+         putCode(Code::Drop_Nul);
          break;
       }
    }
@@ -63,6 +63,35 @@ namespace GDCC::CC
       return n;
    }
 
+   //
+   // InitPackable
+   //
+   // Returns true if elements of the type can be packed.
+   //
+   static bool InitPackable(SR::Type const *type)
+   {
+      return type->isCTypeArith() &&
+         IR::Value_Array::IsPackable(type->getIRType());
+   }
+
+   //
+   // InitPackable
+   //
+   // Returns true if the initializer is a list of undesignated expressions
+   // of arithmetic type.
+   //
+   static bool InitPackable(InitRaw const &raw)
+   {
+      for(auto const &sub : raw.valueSub)
+      {
+         if(!sub.desig.empty() || !sub.valueExp ||
+            !sub.valueExp->getType()->isCTypeArith())
+            return false;
+      }
+
+      return true;
+   }
+
    //
    // SubInit
    //
@@ -531,15 +560,31 @@ namespace GDCC::CC
    //
    Init_Array::Init_Array(SR::Type const *type_, Core::FastU offset_,
       Core::Origin pos_, std::size_t width, Factory &fact_) :
-      Init_Aggregate{type_, offset_, pos_, fact_}, subs{width}
+      Init_Aggregate{type_, offset_, pos_, fact_},
+      packedN{0},
+      subT   {type->getBaseType()},
+      subB   {subT->getSizeBytes()},
+      pack   {InitPackable(subT)}
+   {
+      resize(width);
+   }
+
+   //
+   // Init_Array::createSub
+   //
+   // Creates the Init for an element without one.
+   //
+   Init::Ptr Init_Array::createSub(std::size_t index) const
    {
-      auto subT = type->getBaseType();
-      auto subB = subT->getSizeBytes();
+      auto subO = offset + index * subB;
+
+      if(index >= packedN)
+         return Create(subT, subO, pos, fact);
 
-      std::size_t subC = 0;
+      auto val = IR::Value_Array::Unpack(packed[index], subT->getIRType().tFixed);
+      auto exp = fact.expCreate_IRExp(IR::ExpCreate_Value(std::move(val), pos), subT, pos);
 
-      for(auto &mem : subs)
-         mem = Create(subT, offset + subC++ * subB, pos, fact);
+      return Ptr(new Init_Value(subT, subO, pos, exp, fact));
    }
 
    //
@@ -547,7 +592,28 @@ namespace GDCC::CC
    //
    Init *Init_Array::getSub(std::size_t index)
    {
-      return index < subs.size() ? subs[index].get() : nullptr;
+      if(index >= subs.size())
+         return nullptr;
+
+      if(!subs[index])
+         subs[index] = createSub(index);
+
+      return subs[index].get();
+   }
+
+   //
+   // Init_Array::resize
+   //
+   void Init_Array::resize(std::size_t width)
+   {
+      std::size_t subC = subs.size();
+
+      subs.resize(width);
+
+      if(pack)
+         packed.resize(width);
+      else for(; subC != width; ++subC)
+         subs[subC] = createSub(subC);
    }
 
    //
@@ -556,7 +622,13 @@ namespace GDCC::CC
    void Init_Array::v_genStmnt(SR::GenStmntCtx const &ctx,
       SR::Arg const &arg, bool skipZero) const
    {
-      for(auto const &sub : subs) sub->genStmnt(ctx, arg, skipZero);
+      for(std::size_t i = 0, e = subs.size(); i != e; ++i)
+      {
+         if(subs[i])
+            subs[i]->genStmnt(ctx, arg, skipZero);
+         else
+            createSub(i)->genStmnt(ctx, arg, skipZero);
+      }
    }
 
    //
@@ -564,9 +636,45 @@ namespace GDCC::CC
    //
    IR::Exp::CRef Init_Array::v_getIRExp() const
    {
-      return IR::ExpCreate_Array(type->getBaseType()->getIRType(),
-         {subs.begin(), subs.end(), [](std::unique_ptr<Init> const &ini)
-            {return ini->getIRExp();}}, pos);
+      auto elemT = subT->getIRType();
+
+      // If every element is a constant of the element type, stay packed.
+      if(pack)
+      {
+         Core::Array<Core::FastU> vals{packed.begin(), packed.end()};
+
+         for(std::size_t i = 0, e = subs.size(); i != e; ++i)
+         {
+            if(!subs[i]) continue;
+
+            auto exp = subs[i]->getIRExp();
+            if(!exp->isValue()) goto unpacked;
+
+            auto val = exp->getValue();
+            if(val.v != IR::ValueBase::Fixed || !(val.vFixed.vtype == elemT.tFixed))
+               goto unpacked;
+
+            vals[i] = IR::Value_Array::Pack(val.vFixed);
+         }
+
+         IR::Type_Array valT{elemT, vals.size()};
+         return IR::ExpCreate_Value(
+            IR::Value_Array{std::move(vals), std::move(valT)}, pos);
+      }
+
+   unpacked:
+      std::vector<IR::Exp::CRef> elemV; elemV.reserve(subs.size());
+
+      for(std::size_t i = 0, e = subs.size(); i != e; ++i)
+      {
+         if(subs[i])
+            elemV.emplace_back(subs[i]->getIRExp());
+         else
+            elemV.emplace_back(createSub(i)->getIRExp());
+      }
+
+      return IR::ExpCreate_Array(elemT,
+         {Core::Move, elemV.begin(), elemV.end()}, pos);
    }
 
    //
@@ -574,7 +682,8 @@ namespace GDCC::CC
    //
    bool Init_Array::v_isIRExp() const
    {
-      for(auto const &sub : subs) if(!sub->isIRExp()) return false;
+      // Packed elements are always constant.
+      for(auto const &sub : subs) if(sub && !sub->isIRExp()) return false;
       return true;
    }
 
@@ -583,18 +692,54 @@ namespace GDCC::CC
    //
    bool Init_Array::v_isNoAuto() const
    {
-      for(auto const &sub : subs) if(!sub->isNoAuto()) return false;
+      for(auto const &sub : subs) if(sub && !sub->isNoAuto()) return false;
       return true;
    }
 
+   //
+   // Init_Array::v_parseBlock
+   //
+   void Init_Array::v_parseBlock(InitRaw const &raw, Parser &ctx, Scope &scope)
+   {
+      // A list of plain expressions can be packed directly, without an Init
+      // for each element.
+      if(!pack || parsed || raw.valueSub.size() > subs.size() ||
+         !InitPackable(raw))
+         return Init_Aggregate::v_parseBlock(raw, ctx, scope);
+
+      auto elemT = subT->getIRType();
+
+      std::size_t i = 0;
+      for(auto const &rawSub : raw.valueSub)
+      {
+         auto exp = fact.expPromo_Assign(subT, rawSub.valueExp,
+            rawSub.valueExp->pos);
+
+         if(exp->isIRExp())
+         {
+            auto val = exp->getIRExp()->getValue();
+            if(val.v == IR::ValueBase::Fixed && val.vFixed.vtype == elemT.tFixed)
+            {
+               packed[i] = IR::Value_Array::Pack(val.vFixed);
+               subs[i++].reset();
+               continue;
+            }
+         }
+
+         subs[i].reset(new Init_Value(subT, offset + i * subB,
+            rawSub.valueTok.pos, exp, fact));
+         ++i;
+      }
+
+      packedN = i;
+   }
+
    //
    // Init_Array0 constructor
    //
    Init_Array0::Init_Array0(SR::Type const *type_, Core::FastU offset_,
       Core::Origin pos_, Factory &fact_) :
-      Init_Aggregate{type_, offset_, pos_, fact_},
-      subT{type->getBaseType()},
-      subB{subT->getSizeBytes()}
+      Init_Array{type_, offset_, pos_, 0, fact_}
    {
    }
 
@@ -605,52 +750,29 @@ namespace GDCC::CC
    {
       if(index >= subs.size())
       {
-         do
-            subs.emplace_back(Create(subT, offset + subs.size() * subB, pos, fact));
-         while(index >= subs.size());
+         resize(index + 1);
 
-         type = type->getBaseType()->getTypeArray(subs.size())
-            ->getTypeQual(type->getQual());
+         type = subT->getTypeArray(subs.size())->getTypeQual(type->getQual());
       }
 
-      return subs[index].get();
+      return Init_Array::getSub(index);
    }
 
    //
-   // Init_Array0::v_genStmnt
+   // Init_Array0::v_parseBlock
    //
-   void Init_Array0::v_genStmnt(SR::GenStmntCtx const &ctx,
-      SR::Arg const &arg, bool skipZero) const
+   void Init_Array0::v_parseBlock(InitRaw const &raw, Parser &ctx, Scope &scope)
    {
-      for(auto const &sub : subs) sub->genStmnt(ctx, arg, skipZero);
-   }
-
-   //
-   // Init_Array0::v_getIRExp
-   //
-   IR::Exp::CRef Init_Array0::v_getIRExp() const
-   {
-      return IR::ExpCreate_Array(subT->getIRType(),
-         {subs.begin(), subs.end(), [](std::unique_ptr<Init> const &ini)
-            {return ini->getIRExp();}}, pos);
-   }
+      // Size the array first, so the initializers can be packed.
+      if(pack && !parsed && raw.valueSub.size() > subs.size() &&
+         InitPackable(raw))
+      {
+         resize(raw.valueSub.size());
 
-   //
-   // Init_Array0::v_isIRExp
-   //
-   bool Init_Array0::v_isIRExp() const
-   {
-      for(auto const &sub : subs) if(!sub->isIRExp()) return false;
-      return true;
-   }
+         type = subT->getTypeArray(subs.size())->getTypeQual(type->getQual());
+      }
 
-   //
-   // Init_Array0::v_isNoAuto
-   //
-   bool Init_Array0::v_isNoAuto() const
-   {
-      for(auto const &sub : subs) if(!sub->isNoAuto()) return false;
-      return true;
+      Init_Array::v_parseBlock(raw, ctx, scope);
    }
 
    //
@@ -928,6 +1050,17 @@ namespace GDCC::CC
          fact.expCreate_LitInt(TypeIntegPrS, 0, pos), pos);
    }
 
+   //
+   // Init_Value constructor
+   //
+   Init_Value::Init_Value(SR::Type const *type_, Core::FastU offset_,
+      Core::Origin pos_, SR::Exp const *value_, Factory &fact_) :
+      Init{type_, offset_, pos_, fact_}
+   {
+      value  = value_;
+      parsed = true;
+   }
+
    //
    // Init_Value::v_genStmnt
    //
@@ -176,6 +176,9 @@ namespace GDCC::CC
    //
    // Init_Array
    //
+   // Elements of integer or fixed-point type are kept packed, and only get
+   // an Init when needed.
+   //
    class Init_Array : public Init_Aggregate
    {
    public:
@@ -183,8 +186,12 @@ namespace GDCC::CC
          Core::Origin pos, std::size_t width, Factory &fact);
 
    protected:
+      Ptr createSub(std::size_t index) const;
+
       virtual Init *getSub(std::size_t index);
 
+      void resize(std::size_t width);
+
       virtual void v_genStmnt(SR::GenStmntCtx const &ctx,
          SR::Arg const &dst, bool skipZero) const;
 
@@ -194,13 +201,24 @@ namespace GDCC::CC
 
       virtual bool v_isNoAuto() const;
 
-      Core::Array<std::unique_ptr<Init>> subs;
+      virtual void v_parseBlock(InitRaw const &raw, Parser &ctx, Scope &scope);
+
+      std::vector<std::unique_ptr<Init>> subs;
+
+      // Values of packed elements without an Init. The first packedN were
+      // set by an initializer.
+      std::vector<Core::FastU> packed;
+      std::size_t              packedN;
+
+      SR::Type::CRef const subT;
+      Core::FastU    const subB;
+      bool           const pack;
    };
 
    //
    // Init_Array0
    //
-   class Init_Array0 : public Init_Aggregate
+   class Init_Array0 : public Init_Array
    {
    public:
       Init_Array0(SR::Type const *type, Core::FastU offset,
@@ -209,19 +227,7 @@ namespace GDCC::CC
    protected:
       virtual Init *getSub(std::size_t index);
 
-      virtual void v_genStmnt(SR::GenStmntCtx const &ctx,
-         SR::Arg const &dst, bool skipZero) const;
-
-      virtual IR::Exp::CRef v_getIRExp() const;
-
-      virtual bool v_isIRExp() const;
-
-      virtual bool v_isNoAuto() const;
-
-      std::vector<std::unique_ptr<Init>> subs;
-
-      SR::Type::CRef const subT;
-      Core::FastU    const subB;
+      virtual void v_parseBlock(InitRaw const &raw, Parser &ctx, Scope &scope);
    };
 
    //
@@ -312,6 +318,8 @@ namespace GDCC::CC
    public:
       Init_Value(SR::Type const *type, Core::FastU offset, Core::Origin pos,
          Factory &fact);
+      Init_Value(SR::Type const *type, Core::FastU offset, Core::Origin pos,
+         SR::Exp const *value, Factory &fact);
 
    protected:
       virtual void v_genStmnt(SR::GenStmntCtx const &ctx,
@@ -193,7 +193,7 @@ namespace GDCC::CC
 
       // Convert string to a series of assembly tokens.
       Core::StringBuf sbuf{tok.str.data(), tok.str.size()};
-      AS::TStream     tstr{sbuf, tok.pos.file, tok.pos.line};
+      AS::TStream     tstr{sbuf, tok.pos.getFile(), tok.pos.getLine()};
       AS::LabelTBuf   ltb {*tstr.tkbuf(), scope.fn.fn->glyph};
       AsmGlyphTBuf    gtb {ltb, scope};
       tstr.tkbuf(&gtb);
@@ -17,6 +17,8 @@
 
 #include "../../Core/Number.hpp"
 
+#include <map>
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
@@ -40,7 +42,7 @@ namespace GDCC::CC
       public:
          void setMax(AllocAutoInfo const &alloc);
 
-         std::unordered_map<Core::FastU, Core::FastU> spaceMap;
+         std::map<Core::FastU, Core::FastU> spaceMap;
 
          Core::FastU localArr = 0;
          Core::FastU localAut = 0;
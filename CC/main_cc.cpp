@@ -12,11 +12,16 @@
 
 #include "CC/Parse.hpp"
 
+#include "CPP/ConditionDTBuf.hpp"
+#include "CPP/HeaderCache.hpp"
 #include "CPP/IncludeDTBuf.hpp"
 
+#include "Core/File.hpp"
 #include "Core/Option.hpp"
 
+#include "IR/Cache.hpp"
 #include "IR/Program.hpp"
+#include "IR/Server.hpp"
 
 #include "LD/Linker.hpp"
 
@@ -32,17 +37,32 @@
 //
 static void MakeC()
 {
-   GDCC::IR::Program prog;
+   GDCC::Core::FileDepends deps;
+   GDCC::IR::Program       prog;
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      GDCC::CC::ParseFile(arg, prog);
+      GDCC::IR::CacheParseFile("cc", arg, prog, GDCC::CC::ParseFile);
 
    for(auto const &arg : GDCC::Core::GetOptions().optSysSource)
-      GDCC::CC::ParseFile(arg, prog);
+      GDCC::IR::CacheParseFile("cc", arg, prog, GDCC::CC::ParseFile);
+
+   if(GDCC::Core::GetOptions().optProgress)
+      GDCC::IR::CachePutStats(std::cerr);
 
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
+
+   GDCC::Core::PutOptionDepends(deps, GDCC::Core::GetOptionOutput());
+}
+
+//
+// ClearC
+//
+static void ClearC()
+{
+   GDCC::CPP::ConditionMemoClear();
+   GDCC::CPP::HeaderCacheClear();
 }
 
 
@@ -66,12 +86,28 @@ int main(int argc, char *argv[])
       "Compiles C source into IR data. Output defaults to last loose "
       "argument.";
 
+   opts.optCacheDir.insert(&opts.list);
+   opts.optClient.insert(&opts.list);
+   opts.optDeps.insert(&opts.list);
+   opts.optDepsFile.insert(&opts.list);
+   opts.optDepsPhony.insert(&opts.list);
    opts.optLibPath.insert(&opts.list);
+   opts.optProgress.insert(&opts.list);
+   opts.optServer.insert(&opts.list);
    opts.optSysSource.insert(&opts.list);
 
    try
    {
-      GDCC::Core::ProcessOptions(opts, argc, argv);
+      GDCC::Core::ProcessOptions(opts, argc, argv, false);
+
+      if(opts.optServer.data())
+         GDCC::IR::ServerRun(MakeC, ClearC);
+
+      GDCC::Core::ProcessOptionOutput(opts);
+
+      if(opts.optClient.data())
+         return GDCC::IR::ServerClient();
+
       MakeC();
    }
    catch(std::exception const &e)
@@ -26,6 +26,112 @@
 
 #include "IR/Exp.hpp"
 
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // ConditionKey
+   //
+   class ConditionKey
+   {
+   public:
+      bool operator == (ConditionKey const &key) const {return toks == key.toks;}
+
+      std::vector<std::pair<Core::String, Core::TokenType>> toks;
+   };
+
+   //
+   // ConditionKeyHash
+   //
+   class ConditionKeyHash
+   {
+   public:
+      // Strings are interned, so their indexes are hashed instead of their
+      // contents.
+      std::size_t operator () (ConditionKey const &key) const
+      {
+         std::uint_least64_t hash = 0xCBF29CE484222325;
+         for(auto const &tok : key.toks)
+         {
+            hash = (hash ^ static_cast<std::size_t>(tok.first)) * 0x100000001B3;
+            hash = (hash ^ tok.second) * 0x100000001B3;
+         }
+         return static_cast<std::size_t>(hash);
+      }
+   };
+
+   //
+   // ConditionMemo
+   //
+   // The result of an expression and the macros it used.
+   //
+   class ConditionMemo
+   {
+   public:
+      std::vector<std::pair<Core::String, Macro>> macroDef;
+      std::vector<Core::String>                   macroUnd;
+
+      bool skip;
+   };
+
+   //
+   // ConditionTStream
+   //
+   class ConditionTStream : public Core::TokenStream
+   {
+   public:
+      ConditionTStream(std::vector<Core::Token> const &toks, MacroMap &macros) :
+         Core::TokenStream{&pbuf},
+         abuf{toks.data(), toks.size()},
+         dbuf{abuf, macros},
+         mbuf{dbuf, macros},
+         ibuf{mbuf},
+         sbuf{ibuf},
+         wbuf{sbuf},
+         cbuf{wbuf},
+         pbuf{cbuf}
+      {
+      }
+
+   protected:
+      Core::ArrayTBuf  abuf;
+      DefinedTBuf      dbuf;
+      MacroTBuf        mbuf;
+      IdentiTBuf       ibuf;
+      StringTBuf       sbuf;
+      Core::WSpaceTBuf wbuf;
+      ConcatTBuf       cbuf;
+      PPTokenTBuf      pbuf;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::CPP
+{
+   // Maximum number of results for one expression.
+   static constexpr std::size_t ConditionMemoMax = 8;
+
+   static std::unordered_map<ConditionKey, std::vector<ConditionMemo>,
+      ConditionKeyHash> ConditionMemos;
+
+   // Hashes of expressions seen so far. Results are only recorded for
+   // expressions seen more than once.
+   static std::unordered_set<std::size_t> ConditionSeen;
+}
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -43,26 +149,63 @@ namespace GDCC::CPP
       while(src.peek().tok != Core::TOK_LnEnd && src.peek().tok != Core::TOK_EOF)
          toks.emplace_back(src.get());
 
-      // Set up token stream.
-      Core::ArrayTBuf abuf{toks.data(), toks.size()};
-      DefinedTBuf dbuf{abuf, macros};
-      MacroTBuf mbuf{dbuf, macros};
-      IdentiTBuf ibuf{mbuf};
-      StringTBuf sbuf{ibuf};
-      Core::WSpaceTBuf wbuf{sbuf};
-      ConcatTBuf cbuf{wbuf};
-      PPTokenTBuf pbuf{cbuf};
-      Core::TokenStream in{&pbuf};
-
-      // Read expression.
-      auto exp = GetExp(in);
-
-      // Ensure full consumption.
-      if(in.peek().tok != Core::TOK_EOF)
-         Core::Error(in.peek().pos, "unused tokens");
-
-      // Evaluate expression.
-      return !exp->getValue();
+      // Reuse a previous result if the macros it used are unchanged.
+      ConditionKey key;
+      key.toks.reserve(toks.size());
+      for(auto const &tok : toks)
+         key.toks.emplace_back(tok.str, tok.tok);
+
+      std::vector<ConditionMemo> *memos = nullptr;
+      if(!ConditionSeen.insert(ConditionKeyHash()(key)).second)
+      {
+         memos = &ConditionMemos[std::move(key)];
+         for(auto const &memo : *memos)
+            if(macros.check(memo.macroDef, memo.macroUnd))
+               return memo.skip;
+      }
+
+      std::optional<MacroLog> log;
+      if(memos && memos->size() < ConditionMemoMax)
+         log.emplace(macros);
+
+      bool skip, value;
+
+      // Evaluate with fixed-width integers, if possible. Otherwise, expand
+      // again for the full evaluator so that errors are found in order.
+      std::vector<Core::Token> exps;
+      try
+      {
+         ConditionTStream in{toks, macros};
+         while(in.peek().tok != Core::TOK_EOF)
+            exps.emplace_back(in.get());
+         exps.emplace_back(Core::TokenEOF);
+      }
+      catch(Core::Exception const &)
+      {
+         exps.clear();
+      }
+
+      if(!exps.empty() && GetExpFast(exps.data(), value))
+         skip = !value;
+      else
+      {
+         ConditionTStream in{toks, macros};
+
+         // Read expression.
+         auto exp = GetExp(in);
+
+         // Ensure full consumption.
+         if(in.peek().tok != Core::TOK_EOF)
+            Core::Error(in.peek().pos, "unused tokens");
+
+         // Evaluate expression.
+         skip = !exp->getValue();
+      }
+
+      if(log && !log->special)
+         memos->push_back({std::move(log->defined), std::move(log->undefined), skip});
+
+      return skip;
    }
 
    //
@@ -175,10 +318,26 @@ namespace GDCC::CPP
       {
          DirectiveTBuf::underflow();
          if(tptr() == tend() || tptr()->tok == Core::TOK_EOF || !isSkip()) break;
+
+         // A yielded line end was read directly from src, so the source is
+         // at the start of a line with nothing buffered. Until the next
+         // directive, there is no need to tokenize anything.
+         if(tptr()->tok == Core::TOK_LnEnd)
+            tsrc.skipGroup();
+
          bumpt(1);
       }
    }
 
+   //
+   // ConditionMemoClear
+   //
+   void ConditionMemoClear()
+   {
+      ConditionMemos.clear();
+      ConditionSeen.clear();
+   }
+
    //
    // DefinedTBuf::underflow
    //
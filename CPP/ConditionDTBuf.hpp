@@ -15,6 +15,8 @@
 
 #include "../CPP/DirectiveTBuf.hpp"
 
+#include "../Core/TokenSource.hpp"
+
 #include <vector>
 
 
@@ -30,8 +32,9 @@ namespace GDCC::CPP
    class ConditionDTBuf : public DirectiveTBuf
    {
    public:
-      ConditionDTBuf(Core::TokenBuf &src_, MacroMap &macros_) :
-         DirectiveTBuf{src_}, macros(macros_) {}
+      ConditionDTBuf(Core::TokenBuf &src_, Core::TokenSource &tsrc_,
+         MacroMap &macros_) :
+         DirectiveTBuf{src_}, macros(macros_), tsrc(tsrc_) {}
 
    protected:
       //
@@ -59,6 +62,7 @@ namespace GDCC::CPP
 
       std::vector<CondState> state;
       MacroMap              &macros;
+      Core::TokenSource     &tsrc;
    };
 
    //
@@ -98,5 +102,16 @@ namespace GDCC::CPP
    };
 }
 
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   // Discards all recorded results of conditional expressions.
+   void ConditionMemoClear();
+}
+
 #endif//GDCC__CPP__ConditionDTBuf_H__
 
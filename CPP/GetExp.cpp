@@ -18,6 +18,44 @@
 
 #include "IR/Exp.hpp"
 
+#include <cstdint>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // FastVal
+   //
+   // A value of TypeIntMax or TypeUIntMax.
+   //
+   class FastVal
+   {
+   public:
+      std::int_least64_t getI() const {return static_cast<std::int_least64_t>(v);}
+
+      bool isNeg() const {return !u && getI() < 0;}
+
+      std::uint_least64_t v;
+      bool                u;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::CPP
+{
+   static constexpr std::int_least64_t  FastMaxI = INT64_MAX;
+   static constexpr std::int_least64_t  FastMinI = INT64_MIN;
+   static constexpr std::uint_least64_t FastMaxU = UINT64_MAX;
+}
+
 
 //----------------------------------------------------------------------------|
 // Static Functions                                                           |
@@ -150,6 +188,423 @@ namespace GDCC::CPP
       return IR::ExpCreate_Value(
          IR::Value_Fixed(val, u ? TypeUIntMax() : TypeIntMax()), tok.pos);
    }
+
+   //
+   // FastBool
+   //
+   static FastVal FastBool(bool b)
+   {
+      return {b, false};
+   }
+
+   //
+   // FastPromote
+   //
+   // Converts both operands to a common type. Fails if a negative value
+   // would be converted to unsigned.
+   //
+   static bool FastPromote(FastVal &l, FastVal &r)
+   {
+      if(l.u == r.u) return true;
+
+      if(l.isNeg() || r.isNeg()) return false;
+
+      l.u = r.u = true;
+      return true;
+   }
+
+   //
+   // FastAdd
+   //
+   static bool FastAdd(FastVal &l, FastVal r)
+   {
+      if(!FastPromote(l, r)) return false;
+
+      if(l.u)
+      {
+         if(l.v > FastMaxU - r.v) return false;
+      }
+      else
+      {
+         auto li = l.getI(), ri = r.getI();
+         if(ri > 0 ? li > FastMaxI - ri : li < FastMinI - ri) return false;
+      }
+
+      l.v += r.v;
+      return true;
+   }
+
+   //
+   // FastDiv
+   //
+   // Negative operands are left to the full evaluator.
+   //
+   static bool FastDiv(FastVal &l, FastVal r, bool mod)
+   {
+      if(!FastPromote(l, r) || l.isNeg() || r.isNeg() || !r.v) return false;
+
+      l.v = mod ? l.v % r.v : l.v / r.v;
+      return true;
+   }
+
+   //
+   // FastMul
+   //
+   static bool FastMul(FastVal &l, FastVal r)
+   {
+      if(!FastPromote(l, r)) return false;
+
+      if(l.u)
+      {
+         if(r.v && l.v > FastMaxU / r.v) return false;
+
+         l.v *= r.v;
+         return true;
+      }
+
+      auto li = l.getI(), ri = r.getI();
+      if(li == FastMinI || ri == FastMinI) return false;
+
+      std::uint_least64_t lm = li < 0 ? -li : li, rm = ri < 0 ? -ri : ri;
+      if(rm && lm > static_cast<std::uint_least64_t>(FastMaxI) / rm) return false;
+
+      l.v = (li < 0) != (ri < 0) ? -(lm * rm) : lm * rm;
+      return true;
+   }
+
+   //
+   // FastShift
+   //
+   // Only shifts of non-negative values that do not overflow are handled.
+   //
+   static bool FastShift(FastVal &l, FastVal r, bool left)
+   {
+      if(l.isNeg() || r.isNeg() || r.v >= 64) return false;
+
+      if(left)
+      {
+         if(l.v > (l.u ? FastMaxU : FastMaxI) >> r.v) return false;
+
+         l.v <<= r.v;
+      }
+      else
+         l.v >>= r.v;
+
+      return true;
+   }
+
+   //
+   // FastSub
+   //
+   static bool FastSub(FastVal &l, FastVal r)
+   {
+      if(!FastPromote(l, r)) return false;
+
+      if(l.u)
+      {
+         if(l.v < r.v) return false;
+      }
+      else
+      {
+         auto li = l.getI(), ri = r.getI();
+         if(ri < 0 ? li > FastMaxI + ri : li < FastMinI + ri) return false;
+      }
+
+      l.v -= r.v;
+      return true;
+   }
+
+   static bool GetExpFast(Core::Token const *&in, FastVal &out);
+
+   //
+   // GetExpFast_Prim
+   //
+   static bool GetExpFast_Prim(Core::Token const *&in, FastVal &out)
+   {
+      switch(in->tok)
+      {
+      case Core::TOK_Charac:
+         out = {static_cast<std::uint_least64_t>(
+            static_cast<std::int_least64_t>(*in++->str.begin())), false};
+         return true;
+
+      case Core::TOK_NumInt:
+         {
+            char const *itr = in->str.begin();
+            unsigned    base;
+
+            std::tie(itr, base) = Core::ParseNumberBaseC(itr);
+
+            out = {0, false};
+            for(; Core::IsDigit(*itr, base); ++itr)
+            {
+               unsigned digit = Core::ToDigit(*itr);
+               if(out.v > (FastMaxU - digit) / base) return false;
+               out.v = out.v * base + digit;
+            }
+
+            for(auto end = in->str.end(); itr != end; ++itr)
+               if(*itr == 'U' || *itr == 'u') {out.u = true; break;}
+
+            if(!out.u && out.v > static_cast<std::uint_least64_t>(FastMaxI))
+               return false;
+
+            ++in;
+            return true;
+         }
+
+      case Core::TOK_ParenO:
+         ++in;
+         if(!GetExpFast(in, out) || in->tok != Core::TOK_ParenC) return false;
+         ++in;
+         return true;
+
+      default:
+         return false;
+      }
+   }
+
+   //
+   // GetExpFast_Unar
+   //
+   static bool GetExpFast_Unar(Core::Token const *&in, FastVal &out)
+   {
+      switch(in->tok)
+      {
+      case Core::TOK_Add:
+         return GetExpFast_Unar(++in, out);
+
+      case Core::TOK_Not:
+         if(!GetExpFast_Unar(++in, out)) return false;
+         out = FastBool(!out.v);
+         return true;
+
+      case Core::TOK_Sub:
+         if(!GetExpFast_Unar(++in, out)) return false;
+         if(out.u ? out.v != 0 : out.getI() == FastMinI) return false;
+         out.v = -out.v;
+         return true;
+
+      default:
+         return GetExpFast_Prim(in, out);
+      }
+   }
+
+   //
+   // GetExpFast_Mult
+   //
+   static bool GetExpFast_Mult(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_Unar(in, out)) return false;
+
+      for(FastVal r;;) switch(in->tok)
+      {
+      case Core::TOK_Div:
+         if(!GetExpFast_Unar(++in, r) || !FastDiv(out, r, false)) return false;
+         break;
+
+      case Core::TOK_Mod:
+         if(!GetExpFast_Unar(++in, r) || !FastDiv(out, r, true)) return false;
+         break;
+
+      case Core::TOK_Mul:
+         if(!GetExpFast_Unar(++in, r) || !FastMul(out, r)) return false;
+         break;
+
+      default: return true;
+      }
+   }
+
+   //
+   // GetExpFast_Addi
+   //
+   static bool GetExpFast_Addi(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_Mult(in, out)) return false;
+
+      for(FastVal r;;) switch(in->tok)
+      {
+      case Core::TOK_Add:
+         if(!GetExpFast_Mult(++in, r) || !FastAdd(out, r)) return false;
+         break;
+
+      case Core::TOK_Sub:
+         if(!GetExpFast_Mult(++in, r) || !FastSub(out, r)) return false;
+         break;
+
+      default: return true;
+      }
+   }
+
+   //
+   // GetExpFast_Shft
+   //
+   static bool GetExpFast_Shft(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_Addi(in, out)) return false;
+
+      for(FastVal r;;) switch(in->tok)
+      {
+      case Core::TOK_ShL:
+         if(!GetExpFast_Addi(++in, r) || !FastShift(out, r, true)) return false;
+         break;
+
+      case Core::TOK_ShR:
+         if(!GetExpFast_Addi(++in, r) || !FastShift(out, r, false)) return false;
+         break;
+
+      default: return true;
+      }
+   }
+
+   //
+   // GetExpFast_Rela
+   //
+   static bool GetExpFast_Rela(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_Shft(in, out)) return false;
+
+      for(FastVal r;;)
+      {
+         auto tok = in->tok;
+         if(tok != Core::TOK_CmpGE && tok != Core::TOK_CmpGT &&
+            tok != Core::TOK_CmpLE && tok != Core::TOK_CmpLT)
+            return true;
+
+         if(!GetExpFast_Shft(++in, r) || !FastPromote(out, r)) return false;
+
+         bool lt = out.u ? out.v < r.v : out.getI() < r.getI();
+         bool gt = out.u ? out.v > r.v : out.getI() > r.getI();
+
+         switch(tok)
+         {
+         case Core::TOK_CmpGE: out = FastBool(!lt); break;
+         case Core::TOK_CmpGT: out = FastBool( gt); break;
+         case Core::TOK_CmpLE: out = FastBool(!gt); break;
+         default:              out = FastBool( lt); break;
+         }
+      }
+   }
+
+   //
+   // GetExpFast_Equa
+   //
+   static bool GetExpFast_Equa(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_Rela(in, out)) return false;
+
+      for(FastVal r;;) switch(in->tok)
+      {
+      case Core::TOK_CmpEQ:
+         if(!GetExpFast_Rela(++in, r) || !FastPromote(out, r)) return false;
+         out = FastBool(out.v == r.v);
+         break;
+
+      case Core::TOK_CmpNE:
+         if(!GetExpFast_Rela(++in, r) || !FastPromote(out, r)) return false;
+         out = FastBool(out.v != r.v);
+         break;
+
+      default: return true;
+      }
+   }
+
+   //
+   // GetExpFast_Bits
+   //
+   // Handles &, ^, and | with the precedence of the operator at prec. Bitwise
+   // operations on negative values are left to the full evaluator.
+   //
+   static bool GetExpFast_Bits(Core::Token const *&in, FastVal &out, int prec)
+   {
+      static constexpr Core::TokenType Toks[] =
+         {Core::TOK_And, Core::TOK_OrX, Core::TOK_OrI};
+
+      if(!(prec ? GetExpFast_Bits(in, out, prec - 1) : GetExpFast_Equa(in, out)))
+         return false;
+
+      for(FastVal r; in->tok == Toks[prec];)
+      {
+         if(!(prec ? GetExpFast_Bits(++in, r, prec - 1) : GetExpFast_Equa(++in, r)))
+            return false;
+
+         if(!FastPromote(out, r) || out.isNeg() || r.isNeg()) return false;
+
+         switch(prec)
+         {
+         case 0: out.v &= r.v; break;
+         case 1: out.v ^= r.v; break;
+         case 2: out.v |= r.v; break;
+         }
+      }
+
+      return true;
+   }
+
+   //
+   // GetExpFast_LAnd
+   //
+   // Both operands are always evaluated, so that anything the full evaluator
+   // would diagnose is left to it.
+   //
+   static bool GetExpFast_LAnd(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_Bits(in, out, 2)) return false;
+
+      for(FastVal r; in->tok == Core::TOK_And2;)
+      {
+         if(!GetExpFast_Bits(++in, r, 2)) return false;
+         out = FastBool(out.v && r.v);
+      }
+
+      return true;
+   }
+
+   //
+   // GetExpFast_LOrI
+   //
+   static bool GetExpFast_LOrI(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_LAnd(in, out)) return false;
+
+      for(FastVal r; in->tok == Core::TOK_OrI2;)
+      {
+         if(!GetExpFast_LAnd(++in, r)) return false;
+         out = FastBool(out.v || r.v);
+      }
+
+      return true;
+   }
+
+   //
+   // GetExpFast_Cond
+   //
+   static bool GetExpFast_Cond(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_LOrI(in, out)) return false;
+
+      if(in->tok != Core::TOK_Query) return true;
+
+      FastVal l, r;
+      if(!GetExpFast(++in, l) || in->tok != Core::TOK_Colon) return false;
+      if(!GetExpFast_Cond(++in, r) || !FastPromote(l, r)) return false;
+
+      out = out.v ? l : r;
+      return true;
+   }
+
+   //
+   // GetExpFast
+   //
+   static bool GetExpFast(Core::Token const *&in, FastVal &out)
+   {
+      if(!GetExpFast_Cond(in, out)) return false;
+
+      while(in->tok == Core::TOK_Comma)
+         if(!GetExpFast_Cond(++in, out)) return false;
+
+      return true;
+   }
 }
 
 
@@ -159,6 +614,19 @@ namespace GDCC::CPP
 
 namespace GDCC::CPP
 {
+   //
+   // GetExpFast
+   //
+   bool GetExpFast(Core::Token const *toks, bool &value)
+   {
+      FastVal val;
+      if(!GetExpFast(toks, val) || toks->tok != Core::TOK_EOF)
+         return false;
+
+      value = val.v;
+      return true;
+   }
+
    //
    // GetExp_Prim_NumFix
    //
@@ -38,6 +38,12 @@ namespace GDCC::CPP
    Core::CounterRef<IR::Exp const> GetExp_Cond(Core::TokenStream &in);
    Core::CounterRef<IR::Exp const> GetExp_Assi(Core::TokenStream &in);
    Core::CounterRef<IR::Exp const> GetExp(Core::TokenStream &in);
+
+   // Evaluates an expression in toks, which must end with TOK_EOF, using
+   // 64-bit integers. Returns false if the expression uses anything not
+   // handled here, including anything that would be an error or overflow, in
+   // which case GetExp must be used instead.
+   bool GetExpFast(Core::Token const *toks, bool &value);
 }
 
 #endif//GDCC__CPP__GetExp_H__
@@ -0,0 +1,245 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Preprocessed header cache.
+//
+// Headers included while the cache is enabled are recorded into tables. A
+// later inclusion of the same header, whether in the same translation unit
+// or another one processed by the same run, plays back a table instead if
+// the macros it looked up and the contents of the files it read are
+// unchanged. A header can have several tables, such as for the first and
+// subsequent inclusions of a guarded header.
+//
+//-----------------------------------------------------------------------------
+
+#include "CPP/HeaderCache.hpp"
+
+#include "CPP/HeaderTable.hpp"
+
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+
+#include "Option/Bool.hpp"
+
+#include <memory>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // --header-cache
+   //
+   static Option::Bool HeaderCacheOpt
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("header-cache")
+         .setGroup("preprocessor")
+         .setDescS("Reuses the tokens of previously included headers.")
+         .setDescL("Reuses the tokens of previously included headers. A "
+            "header's tokens are reused if its contents and the macros it "
+            "uses are unchanged. Headers using __DATE__, __FILE__, __LINE__, "
+            "or __TIME__ are always read again.\n"
+            "\n"
+            "Default is on."),
+
+      true
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // HeaderCacheEntry
+   //
+   class HeaderCacheEntry
+   {
+   public:
+      std::unique_ptr<HeaderTable> table;
+
+      // Content hashes of the table's files.
+      std::vector<std::size_t> hashes;
+
+      // Files looked for but not found while recording.
+      std::vector<std::string> absent;
+   };
+
+   //
+   // HeaderCacheSet
+   //
+   class HeaderCacheSet
+   {
+   public:
+      std::vector<HeaderCacheEntry> entries;
+
+      // Recordings that could not be used.
+      std::size_t rejects = 0;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::CPP
+{
+   // Maximum number of tables and rejected recordings for one header.
+   static constexpr std::size_t HeaderCacheMax = 8;
+
+   static std::unordered_map<Core::String, HeaderCacheSet> HeaderCacheSets;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // HeaderCacheHash
+   //
+   // Returns false if the file cannot be read.
+   //
+   static bool HeaderCacheHash(Core::String name, std::size_t &hash)
+   {
+      auto block = Core::FileTryBlock(name.data());
+      if(!block)
+         return false;
+
+      hash = block->getHash();
+      return true;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // HeaderCacheAdd
+   //
+   void HeaderCacheAdd(HeaderRecord &rec)
+   {
+      auto &set = HeaderCacheSets[rec.table.files[0]];
+
+      if(rec.log.special)
+      {
+         ++set.rejects;
+         return;
+      }
+
+      HeaderCacheEntry entry;
+      entry.hashes.resize(rec.table.files.size());
+
+      for(std::size_t i = 0, e = rec.table.files.size(); i != e; ++i)
+      {
+         if(!HeaderCacheHash(rec.table.files[i], entry.hashes[i]))
+         {
+            ++set.rejects;
+            return;
+         }
+      }
+
+      entry.absent = rec.deps.absent;
+      entry.table.reset(new HeaderTable(std::move(rec.table)));
+      set.entries.emplace_back(std::move(entry));
+   }
+
+   //
+   // HeaderCacheClear
+   //
+   void HeaderCacheClear()
+   {
+      HeaderCacheSets.clear();
+   }
+
+   //
+   // HeaderCacheFind
+   //
+   HeaderTable const *HeaderCacheFind(Core::String name, MacroMap &macros)
+   {
+      if(!HeaderCacheOpt)
+         return nullptr;
+
+      auto itr = HeaderCacheSets.find(name);
+      if(itr == HeaderCacheSets.end())
+         return nullptr;
+
+      auto &entries = itr->second.entries;
+      for(auto entry = entries.begin(); entry != entries.end(); ++entry)
+      {
+         if(!entry->table->check(macros))
+            continue;
+
+         // Files that have changed invalidate the table.
+         auto const &files = entry->table->files;
+         for(std::size_t i = 0, e = files.size(); i != e; ++i)
+         {
+            std::size_t hash;
+            if(!HeaderCacheHash(files[i], hash) || hash != entry->hashes[i])
+            {
+               entries.erase(entry);
+               return nullptr;
+            }
+         }
+
+         // As do files that now exist, which would have been found instead.
+         for(auto const &file : entry->absent)
+         {
+            if(Core::FileTryBlock(file.data()))
+            {
+               entries.erase(entry);
+               return nullptr;
+            }
+         }
+
+         // The header itself has already been added.
+         for(auto file = files.begin() + 1, end = files.end(); file != end; ++file)
+            Core::FileDepends::Add(file->data(), file->size());
+
+         for(auto const &file : entry->absent)
+            Core::FileDepends::AddAbsent(file.data(), file.size());
+
+         return entry->table.get();
+      }
+
+      return nullptr;
+   }
+
+   //
+   // HeaderCacheWant
+   //
+   bool HeaderCacheWant(Core::String name)
+   {
+      if(!HeaderCacheOpt)
+         return false;
+
+      auto itr = HeaderCacheSets.find(name);
+      if(itr == HeaderCacheSets.end())
+         return true;
+
+      return itr->second.entries.size() + itr->second.rejects < HeaderCacheMax;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,42 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Preprocessed header cache.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__CPP__HeaderCache_H__
+#define GDCC__CPP__HeaderCache_H__
+
+#include "../CPP/Types.hpp"
+
+#include "../Core/String.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   // Stores a completed recording, if it can be reused.
+   void HeaderCacheAdd(HeaderRecord &rec);
+
+   // Discards all stored tables.
+   void HeaderCacheClear();
+
+   // Returns a table for the named header that is valid for the current
+   // macros and files, if there is one. Its files are added as dependencies.
+   HeaderTable const *HeaderCacheFind(Core::String name, MacroMap &macros);
+
+   // Returns true if including the named header should be recorded.
+   bool HeaderCacheWant(Core::String name);
+}
+
+#endif//GDCC__CPP__HeaderCache_H__
+
@@ -0,0 +1,150 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Recorded header tables.
+//
+// A table is built from a header by recording the tokens it produces along
+// with the macro and pragma changes made between them, and the external
+// macros it looked up. If the looked up macros are unchanged, the table can
+// be played back instead of preprocessing the header.
+//
+//-----------------------------------------------------------------------------
+
+#include "CPP/HeaderTable.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // HeaderPragma::parse
+   //
+   bool HeaderPragma::parse(Core::Token const *toks, std::size_t n)
+   {
+      table.events.emplace_back(table.toks.size(), HeaderEvent::Kind::Pragma);
+      table.events.back().toks.assign(toks, toks + n);
+
+      return pragp.parse(toks, n);
+   }
+
+   //
+   // HeaderRecord constructor
+   //
+   HeaderRecord::HeaderRecord(Core::String name, MacroMap &macros_,
+      PragmaParserBase &pragp) :
+      pragr {pragp, table},
+      log   {macros_},
+      macros{macros_},
+      added {0}
+   {
+      table.files.push_back(name);
+   }
+
+   //
+   // HeaderRecord::put
+   //
+   void HeaderRecord::put(Core::Token const &tok)
+   {
+      putEvents();
+      table.toks.push_back(tok);
+   }
+
+   //
+   // HeaderRecord::putEnd
+   //
+   void HeaderRecord::putEnd()
+   {
+      putEvents();
+
+      for(auto const &file : deps.files)
+         if(file != table.files[0].data())
+            table.files.emplace_back(file.data(), file.size());
+
+      table.macroDef = std::move(log.defined);
+      table.macroUnd = std::move(log.undefined);
+   }
+
+   //
+   // HeaderRecord::putEvents
+   //
+   // Records the state of any macros changed since the last token.
+   //
+   void HeaderRecord::putEvents()
+   {
+      for(auto end = log.added.size(); added != end; ++added)
+      {
+         auto const &name = log.added[added];
+         if(auto macro = macros.find({{}, name, Core::TOK_Identi}))
+         {
+            table.events.emplace_back(table.toks.size(), HeaderEvent::Kind::Define, name);
+            table.events.back().macro = *macro;
+         }
+         else
+            table.events.emplace_back(table.toks.size(), HeaderEvent::Kind::Undef, name);
+      }
+   }
+
+   //
+   // HeaderTable::check
+   //
+   bool HeaderTable::check(MacroMap &macros) const
+   {
+      return macros.check(macroDef, macroUnd);
+   }
+
+   //
+   // HeaderTBuf constructor
+   //
+   HeaderTBuf::HeaderTBuf(HeaderTable const &table_, MacroMap &macros_,
+      PragmaParserBase &pragp_) :
+      table {table_},
+      macros{macros_},
+      pragp {pragp_},
+      event {table_.events.begin()}
+   {
+      auto data = const_cast<Core::Token *>(table.toks.data());
+      sett(data, data, data);
+   }
+
+   //
+   // HeaderTBuf::underflow
+   //
+   void HeaderTBuf::underflow()
+   {
+      if(tptr() != tend()) return;
+
+      std::size_t index = tptr() - tbegin();
+
+      for(auto end = table.events.end(); event != end && event->index == index; ++event)
+      {
+         switch(event->kind)
+         {
+         case HeaderEvent::Kind::Define:
+            macros.add(event->name, event->macro);
+            break;
+
+         case HeaderEvent::Kind::Pragma:
+            pragp.parse(event->toks.data(), event->toks.size());
+            break;
+
+         case HeaderEvent::Kind::Undef:
+            macros.rem(event->name);
+            break;
+         }
+      }
+
+      if(index != table.toks.size())
+         sett(tbegin(), tptr(), tptr() + 1);
+   }
+}
+
+// EOF
+
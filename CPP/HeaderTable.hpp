@@ -0,0 +1,161 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Recorded header tables.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__CPP__HeaderTable_H__
+#define GDCC__CPP__HeaderTable_H__
+
+#include "../CPP/Macro.hpp"
+#include "../CPP/Pragma.hpp"
+
+#include "../Core/File.hpp"
+#include "../Core/TokenStream.hpp"
+
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // HeaderEvent
+   //
+   // An effect of a header's directives, applied before reading a token.
+   //
+   class HeaderEvent
+   {
+   public:
+      enum class Kind
+      {
+         Define,
+         Pragma,
+         Undef,
+      };
+
+
+      HeaderEvent() = default;
+      HeaderEvent(std::size_t index_, Kind kind_, Core::String name_ = nullptr) :
+         index{index_}, kind{kind_}, name{name_} {}
+
+      std::size_t              index;
+      Kind                     kind;
+      Core::String             name;
+      Macro                    macro{Macro::List()};
+      std::vector<Core::Token> toks;
+   };
+
+   //
+   // HeaderTable
+   //
+   // The tokens and directive effects of including a header, so that it can
+   // be included again without being read and preprocessed.
+   //
+   class HeaderTable
+   {
+   public:
+      // Returns true if the table is valid for the current macros.
+      bool check(MacroMap &macros) const;
+
+      // Files read, starting with the header itself.
+      std::vector<Core::String> files;
+
+      std::vector<Core::Token> toks;
+      std::vector<HeaderEvent> events;
+
+      // Macros the header depends on.
+      std::vector<std::pair<Core::String, Macro>> macroDef;
+      std::vector<Core::String>                   macroUnd;
+   };
+
+   //
+   // HeaderPragma
+   //
+   // Forwards to another pragma parser, recording the pragmas as events.
+   //
+   class HeaderPragma : public PragmaParserBase
+   {
+   public:
+      HeaderPragma(PragmaParserBase &pragp_, HeaderTable &table_) :
+         pragp{pragp_}, table{table_} {}
+
+      virtual bool parse(Core::Token const *toks, std::size_t n);
+
+      PragmaParserBase &pragp;
+      HeaderTable      &table;
+   };
+
+   //
+   // HeaderRecord
+   //
+   // While in scope, records a header's effects into a table. Each token
+   // read from the header must be passed to put, followed by a call to
+   // putEnd after the last one.
+   //
+   class HeaderRecord
+   {
+   public:
+      HeaderRecord(Core::String name, MacroMap &macros, PragmaParserBase &pragp);
+
+      void put(Core::Token const &tok);
+
+      void putEnd();
+
+      HeaderTable       table;
+      HeaderPragma      pragr;
+      Core::FileDepends deps;
+      MacroLog          log;
+
+   private:
+      void putEvents();
+
+      MacroMap   &macros;
+      std::size_t added;
+   };
+
+   //
+   // HeaderTBuf
+   //
+   class HeaderTBuf : public Core::TokenBuf
+   {
+   public:
+      HeaderTBuf(HeaderTable const &table, MacroMap &macros,
+         PragmaParserBase &pragp);
+
+   protected:
+      virtual void underflow();
+
+      HeaderTable const &table;
+      MacroMap          &macros;
+      PragmaParserBase  &pragp;
+
+      std::vector<HeaderEvent>::const_iterator event;
+   };
+
+   //
+   // HeaderStream
+   //
+   class HeaderStream : public Core::TokenStream
+   {
+   public:
+      HeaderStream(HeaderTable const &table, MacroMap &macros,
+         PragmaParserBase &pragp) :
+         Core::TokenStream{&hbuf}, hbuf{table, macros, pragp} {}
+
+   protected:
+      HeaderTBuf hbuf;
+   };
+}
+
+#endif//GDCC__CPP__HeaderTable_H__
+
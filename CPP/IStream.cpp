@@ -0,0 +1,51 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// C input stream.
+//
+//-----------------------------------------------------------------------------
+
+#include "CPP/IStream.hpp"
+
+#include "Core/StringBuf.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::CPP
+{
+   //
+   // IStream constructor
+   //
+   IStream::IStream(std::streambuf &buf, Core::String file, std::size_t line) :
+      std::istream{&bbuf},
+      wbuf{buf},
+      lbuf{wbuf},
+      obuf{lbuf, {file, line, 1}},
+      tbuf{obuf},
+      ebuf{tbuf},
+      nbuf{ebuf},
+      bbuf{nbuf},
+      orig{&obuf}
+   {
+      using Mode = Core::SourceBuf::Mode;
+
+      auto str = dynamic_cast<Core::StringBuf *>(&buf);
+      if(!str || !Core::SourceBuf::Check(str->data(), str->size(), {file, line, 1}, Mode::C))
+         return;
+
+      sbuf.reset(new Core::SourceBuf{str->data(), str->size(), {file, line, 1}, Mode::C});
+      orig = sbuf.get();
+      rdbuf(sbuf.get());
+   }
+}
+
+// EOF
+
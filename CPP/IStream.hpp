@@ -20,9 +20,11 @@
 #include "../Core/FeatureHold.hpp"
 #include "../Core/LineTermBuf.hpp"
 #include "../Core/OriginBuf.hpp"
+#include "../Core/SourceBuf.hpp"
 #include "../Core/UTFBuf.hpp"
 
 #include <istream>
+#include <memory>
 
 
 //----------------------------------------------------------------------------|
@@ -34,22 +36,16 @@ namespace GDCC::CPP
    //
    // IStream
    //
+   // If buf is a Core::StringBuf, its contents are read directly by a
+   // Core::SourceBuf when possible. Otherwise, characters are passed through
+   // the chain of filtering streambufs.
+   //
    class IStream : public std::istream
    {
    public:
-      IStream(std::streambuf &buf, Core::String file, std::size_t line = 1) :
-         std::istream{&bbuf},
-         wbuf{buf},
-         lbuf{wbuf},
-         obuf{lbuf, {file, line, 1}},
-         tbuf{obuf},
-         ebuf{tbuf},
-         nbuf{ebuf},
-         bbuf{nbuf}
-      {
-      }
+      IStream(std::streambuf &buf, Core::String file, std::size_t line = 1);
 
-      Core::OriginSource &getOriginSource() {return obuf;}
+      Core::OriginSource &getOriginSource() {return *orig;}
 
    protected:
       using WBuf = Core::UTF8to32Buf<>;
@@ -67,6 +63,10 @@ namespace GDCC::CPP
       EBuf ebuf;
       NBuf nbuf;
       BBuf bbuf;
+
+      std::unique_ptr<Core::SourceBuf> sbuf;
+
+      Core::OriginSource *orig;
    };
 }
 
@@ -12,19 +12,22 @@
 
 #include "CPP/IncludeDTBuf.hpp"
 
+#include "CPP/HeaderCache.hpp"
+#include "CPP/HeaderTable.hpp"
 #include "CPP/IStream.hpp"
 #include "CPP/Macro.hpp"
 #include "CPP/TSource.hpp"
 #include "CPP/TStream.hpp"
 
 #include "Core/Exception.hpp"
+#include "Core/File.hpp"
 #include "Core/Option.hpp"
 #include "Core/Parse.hpp"
 #include "Core/Path.hpp"
+#include "Core/StringBuf.hpp"
 
 #include "Option/Bool.hpp"
 
-#include <fstream>
 #include <sstream>
 
 
@@ -129,11 +132,20 @@ namespace GDCC::CPP
    {
       macros.linePush(Macro::Stringize(name));
 
+      if(auto table = HeaderCacheFind(name, macros))
+      {
+         inc.reset(new HeaderStream(*table, macros, pragp));
+         return;
+      }
+
+      if(HeaderCacheWant(name))
+         rec.reset(new HeaderRecord(name, macros, pragp));
+
       incBuf = std::move(newBuf);
       incStr.reset(new IStream(*incBuf, name));
       incSrc.reset(new TSource(*incStr, incStr->getOriginSource()));
-      inc.reset(new IncStream(*incSrc, langs, macros, pragd, pragp,
-         Core::PathDirname(name)));
+      inc.reset(new IncStream(*incSrc, langs, macros, pragd,
+         rec ? rec->pragr : pragp, Core::PathDirname(name)));
    }
 
    //
@@ -215,28 +227,46 @@ namespace GDCC::CPP
          Core::Error(tok.pos, "invalid include syntax");
    }
 
+   //
+   // IncludeDTBuf::tryInc
+   //
+   bool IncludeDTBuf::tryInc(std::string const &name)
+   {
+      auto block = Core::FileTryBlock(name.data());
+
+      if(!block)
+      {
+         Core::FileDepends::AddAbsent(name.data(), name.size());
+         return false;
+      }
+
+      Core::FileDepends::Add(name.data(), name.size());
+
+      doInc({name.data(), name.size()},
+         std::unique_ptr<std::streambuf>{new Core::StringBuf{std::move(block)}});
+      return true;
+   }
+
    //
    // IncludeDTBuf::tryIncSys
    //
    bool IncludeDTBuf::tryIncSys(Core::String name)
    {
-      std::unique_ptr<std::filebuf> fbuf{new std::filebuf()};
-
       // Try specified directories.
       for(auto sys : IncludeSys)
       {
          std::string tmp{sys};
          Core::PathAppend(tmp, name);
-         if(fbuf->open(tmp.data(), std::ios_base::in))
-            return doInc({tmp.data(), tmp.size()}, std::move(fbuf)), true;
+         if(tryInc(tmp))
+            return true;
       }
 
       // Try language directories.
       if(IncludeLangEnable) for(auto lang : langs)
       {
          Core::PathAppend(lang, name);
-         if(fbuf->open(lang.data(), std::ios_base::in))
-            return doInc({lang.data(), lang.size()}, std::move(fbuf)), true;
+         if(tryInc(lang))
+            return true;
       }
 
       return false;
@@ -247,15 +277,13 @@ namespace GDCC::CPP
    //
    bool IncludeDTBuf::tryIncUsr(Core::String name)
    {
-      std::unique_ptr<std::filebuf> fbuf{new std::filebuf()};
-
       // Try current directory.
       if(dir)
       {
          std::string tmp{dir.data(), dir.size()};
          Core::PathAppend(tmp, name);
-         if(fbuf->open(tmp.data(), std::ios_base::in))
-            return doInc({tmp.data(), tmp.size()}, std::move(fbuf)), true;
+         if(tryInc(tmp))
+            return true;
       }
 
       // Try specified directories.
@@ -263,8 +291,8 @@ namespace GDCC::CPP
       {
          std::string tmp{usr};
          Core::PathAppend(tmp, name);
-         if(fbuf->open(tmp.data(), std::ios_base::in))
-            return doInc({tmp.data(), tmp.size()}, std::move(fbuf)), true;
+         if(tryInc(tmp))
+            return true;
       }
 
       return false;
@@ -280,13 +308,23 @@ namespace GDCC::CPP
       if(inc)
       {
          if(*inc >> buf[0])
+         {
+            if(rec) rec->put(buf[0]);
             return sett(buf, buf, buf + 1);
+         }
 
          macros.lineDrop();
          inc.reset();
          incSrc.reset();
          incStr.reset();
          incBuf.reset();
+
+         if(rec)
+         {
+            rec->putEnd();
+            HeaderCacheAdd(*rec);
+            rec.reset();
+         }
       }
 
       DirectiveTBuf::underflow();
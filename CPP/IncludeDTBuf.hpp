@@ -16,6 +16,7 @@
 #include "../CPP/DirectiveTBuf.hpp"
 
 #include <memory>
+#include <string>
 #include <vector>
 
 
@@ -47,11 +48,14 @@ namespace GDCC::CPP
 
       void readInc(Core::Token const &tok);
 
+      bool tryInc(std::string const &name);
       bool tryIncSys(Core::String name);
       bool tryIncUsr(Core::String name);
 
       virtual void underflow();
 
+      // Declared first, as it must outlive the included stream.
+      std::unique_ptr<HeaderRecord>      rec;
       std::unique_ptr<std::streambuf>    incBuf;
       std::unique_ptr<IStream>           incStr;
       std::unique_ptr<Core::TokenSource> incSrc;
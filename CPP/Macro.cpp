@@ -15,6 +15,7 @@
 #include "CPP/IStream.hpp"
 #include "CPP/TSource.hpp"
 
+#include "Core/File.hpp"
 #include "Core/Option.hpp"
 #include "Core/SourceTBuf.hpp"
 #include "Core/StringBuf.hpp"
@@ -337,6 +338,60 @@ namespace GDCC::CPP
       }
    }
 
+   //
+   // MacroLog constructor
+   //
+   MacroLog::MacroLog(MacroMap &macros_) :
+      special{false},
+      macros {macros_},
+      prev   {macros_.log}
+   {
+      macros.log = this;
+   }
+
+   //
+   // MacroLog destructor
+   //
+   MacroLog::~MacroLog()
+   {
+      macros.log = prev;
+   }
+
+   //
+   // MacroLog::add
+   //
+   void MacroLog::add(Core::String name)
+   {
+      names.insert(name);
+      added.push_back(name);
+
+      if(prev) prev->add(name);
+   }
+
+   //
+   // MacroLog::find
+   //
+   void MacroLog::find(Core::String name, Macro const *macro)
+   {
+      if(prev) prev->find(name, macro);
+
+      if(!names.insert(name).second) return;
+
+      if(macro)
+         defined.emplace_back(name, *macro);
+      else
+         undefined.push_back(name);
+   }
+
+   //
+   // MacroLog::findSpecial
+   //
+   void MacroLog::findSpecial()
+   {
+      for(auto log = this; log; log = log->prev)
+         log->special = true;
+   }
+
    //
    // MacroMap constructor
    //
@@ -344,7 +399,8 @@ namespace GDCC::CPP
       macroDATE{Macro::List(1)},
       macroFILE{Macro::List(1)},
       macroLINE{Macro::List(1)},
-      macroTIME{Macro::List(1)}
+      macroTIME{Macro::List(1)},
+      log      {nullptr}
    {
       reset();
       linePush(file, line);
@@ -355,6 +411,8 @@ namespace GDCC::CPP
    //
    void MacroMap::add(Core::String name, Macro const &macro)
    {
+      if(log) log->add(name);
+
       table.erase(name);
 
       table.emplace(name, macro);
@@ -365,11 +423,33 @@ namespace GDCC::CPP
    //
    void MacroMap::add(Core::String name, Macro &&macro)
    {
+      if(log) log->add(name);
+
       table.erase(name);
 
       table.emplace(name, std::move(macro));
    }
 
+   //
+   // MacroMap::check
+   //
+   bool MacroMap::check(std::vector<std::pair<Core::String, Macro>> const &defined,
+      std::vector<Core::String> const &undefined)
+   {
+      for(auto const &name : undefined)
+         if(find({{}, name, Core::TOK_Identi}))
+            return false;
+
+      for(auto const &macro : defined)
+      {
+         auto found = find({{}, macro.first, Core::TOK_Identi});
+         if(!found || *found != macro.second)
+            return false;
+      }
+
+      return true;
+   }
+
    //
    // MacroMap::find
    //
@@ -379,24 +459,35 @@ namespace GDCC::CPP
 
       switch(tok.str)
       {
-      case Core::STR___DATE__: return &macroDATE;
-      case Core::STR___TIME__: return &macroTIME;
+      case Core::STR___DATE__:
+         if(log) log->findSpecial();
+         Core::FileDepends::SetSpecial();
+         return &macroDATE;
+
+      case Core::STR___TIME__:
+         if(log) log->findSpecial();
+         Core::FileDepends::SetSpecial();
+         return &macroTIME;
 
       case Core::STR___FILE__:
+         if(log) log->findSpecial();
          if(lines.empty()) return nullptr;
 
          macroFILE.list[0].str = lines.back().first;
          return &macroFILE;
 
       case Core::STR___LINE__:
+         if(log) log->findSpecial();
          if(lines.empty()) return nullptr;
 
-         macroLINE.list[0].str = Macro::MakeString(tok.pos.line + lines.back().second);
+         macroLINE.list[0].str = Macro::MakeString(tok.pos.getLine() + lines.back().second);
          return &macroLINE;
 
       default:
-         auto itr = table.find(tok.str);
-         return itr == table.end() ? nullptr : &itr->second;
+         auto itr  = table.find(tok.str);
+         auto find = itr == table.end() ? nullptr : &itr->second;
+         if(log) log->find(tok.str, find);
+         return find;
       }
    }
 
@@ -440,6 +531,8 @@ namespace GDCC::CPP
    //
    void MacroMap::rem(Core::String name)
    {
+      if(log) log->add(name);
+
       table.erase(name);
    }
 
@@ -20,6 +20,7 @@
 #include "../Core/Token.hpp"
 
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 
@@ -77,6 +78,43 @@ namespace GDCC::CPP
       static void Stringize(std::string &tmp, Core::Token const &tok);
    };
 
+   //
+   // MacroLog
+   //
+   // While in scope, records the macro names looked up in a MacroMap and
+   // their definitions at the time. Names already added or removed during
+   // the log are not recorded, as their state is not external. Logs nest, so
+   // that an outer log also records everything seen by an inner one.
+   //
+   class MacroLog
+   {
+   public:
+      explicit MacroLog(MacroMap &macros);
+      MacroLog(MacroLog const &) = delete;
+      ~MacroLog();
+
+      MacroLog &operator = (MacroLog const &) = delete;
+
+      void add(Core::String name);
+
+      void find(Core::String name, Macro const *macro);
+
+      void findSpecial();
+
+      std::vector<std::pair<Core::String, Macro>> defined;
+      std::vector<Core::String>                   undefined;
+      std::vector<Core::String>                   added;
+
+      // Set if __DATE__, __FILE__, __LINE__, or __TIME__ were looked up.
+      bool special;
+
+   private:
+      std::unordered_set<Core::String> names;
+
+      MacroMap &macros;
+      MacroLog *prev;
+   };
+
    //
    // MacroMap
    //
@@ -89,6 +127,10 @@ namespace GDCC::CPP
       void add(Core::String name, Macro const &macro);
       void add(Core::String name, Macro &&macro);
 
+      // Returns true if the macros recorded by a MacroLog are unchanged.
+      bool check(std::vector<std::pair<Core::String, Macro>> const &defined,
+         std::vector<Core::String> const &undefined);
+
       // Gets the macro by the specified name or null if not defined.
       Macro const *find(Core::Token const &tok);
 
@@ -110,10 +152,14 @@ namespace GDCC::CPP
       void reset();
 
    private:
+      friend class MacroLog;
+
       std::vector<std::pair<Core::String, std::size_t>> lines;
       std::unordered_map<Core::String, Macro>           table;
 
       Macro macroDATE, macroFILE, macroLINE, macroTIME;
+
+      MacroLog *log;
    };
 }
 
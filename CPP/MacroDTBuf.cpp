@@ -202,7 +202,7 @@ namespace GDCC::CPP
          Core::ErrorExpect("digit-sequence", mbuf.peek());
       }
 
-      macros.lineLine(num - numTok.pos.line);
+      macros.lineLine(num - numTok.pos.getLine());
 
       while(mbuf.peek().tok == Core::TOK_WSpace) mbuf.get();
 
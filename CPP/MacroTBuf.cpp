@@ -16,8 +16,8 @@
 
 #include "Core/Exception.hpp"
 
+#include <algorithm>
 #include <cctype>
-#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -26,27 +26,6 @@
 
 namespace GDCC::CPP
 {
-   //
-   // FindArg
-   //
-   static MacroTBuf::Rng const *FindArg(Core::Token const &tok,
-      Macro const &macro, Core::Array<MacroTBuf::Rng> const &argv,
-      Core::String vaArgStr)
-   {
-      if(tok.tok != Core::TOK_Identi) return nullptr;
-
-      if(tok.str == vaArgStr && !macro.args.empty() && !macro.args.back())
-         return &argv.back();
-
-      for(auto itr = macro.args.begin(), end = macro.args.end(); itr != end; ++itr)
-      {
-         if(tok.str == *itr)
-            return &argv[itr - macro.args.begin()];
-      }
-
-      return nullptr;
-   }
-
    //
    // IsConcat
    //
@@ -78,66 +57,6 @@ namespace GDCC::CPP
 
       return true;
    }
-
-   //
-   // MakeArgs
-   //
-   static Core::Array<MacroTBuf::Rng>
-   MakeArgs(Macro const &macro, MacroTBuf::Rng const &argRng)
-   {
-      // Build argument token ranges, if any.
-
-      if(macro.args.empty())
-      {
-         if(!IsEmpty(argRng))
-            Core::Error(argRng.begin()->pos, "args to no-arg macro");
-
-         return {};
-      }
-      else
-      {
-         Core::Array<MacroTBuf::Rng> argv{macro.args.size()};
-         auto argi = argv.begin();
-
-         argi->first = argRng.first;
-
-         std::size_t depth = 0;
-         for(auto itr = argRng.begin(), end = argRng.end(); itr != end;)
-         {
-               if(itr->tok == Core::TOK_ParenO) ++depth;
-            else if(itr->tok == Core::TOK_ParenC) --depth;
-            else if(itr->tok == Core::TOK_Comma && !depth)
-            {
-               if(argi + 1 == argv.end())
-               {
-                  if(macro.args.back())
-                     Core::Error(itr->pos, "too many macro args");
-                  else
-                     break;
-               }
-
-               argi++->last = itr++;
-               argi->first = itr;
-
-               continue;
-            }
-
-            ++itr;
-         }
-
-         argi->last = argRng.last;
-
-         if(argi + 1 != argv.end())
-         {
-            if(macro.args.back() || argi + 2 != argv.end())
-               Core::Error(argRng.begin()->pos, "not enough macro args");
-
-            *++argi = {argRng.end(), argRng.end()};
-         }
-
-         return argv;
-      }
-   }
 }
 
 
@@ -152,6 +71,7 @@ namespace GDCC::CPP
    //
    MacroTBuf::MacroTBuf(Core::TokenBuf &src_, MacroMap &macros_,
       Core::String vaArgStr_) :
+      argSrc{nullptr, 0},
       macros(macros_), src(src_), vaArgStr{vaArgStr_}, ignoreAll{false}
    {
    }
@@ -159,97 +79,103 @@ namespace GDCC::CPP
    //
    // MacroTBuf::applyMarker
    //
-   void MacroTBuf::applyMarker(Core::String str)
+   void MacroTBuf::applyMarker(Core::String name)
    {
-      if(str == Core::STR_TOK_Add)
+      if(name == Core::STR_TOK_Add)
          ignoreAll = true;
-      else if(str == Core::STR_TOK_Sub)
+      else if(name == Core::STR_TOK_Sub)
          ignoreAll = false;
-      else if(str)
+      else if(name)
       {
-         if(ignore.count(str))
-            ignore.erase(str);
+         auto itr = std::find(ignore.begin(), ignore.end(), name);
+
+         if(itr != ignore.end())
+            ignore.erase(itr);
          else
-            ignore.emplace(str);
+            ignore.push_back(name);
       }
    }
 
    //
    // MacroTBuf::expand
    //
-   bool MacroTBuf::expand(Itr itr)
+   bool MacroTBuf::expand()
    {
-      if(itr == buf.end()) {buf.emplace(itr, src.get()); --itr;}
+      if(buf.empty()) buf.push_back(src.get());
 
       // Marker handling.
-      if(itr->tok == Core::TOK_Marker)
+      if(buf.back().tok == Core::TOK_Marker)
       {
-         applyMarker(itr->str);
+         applyMarker(buf.back().str);
 
-         buf.erase(itr);
+         buf.pop_back();
          return true;
       }
 
-      if(ignoreAll || itr->tok != Core::TOK_Identi || ignore.count(itr->str))
+      if(ignoreAll || buf.back().tok != Core::TOK_Identi || isIgnore(buf.back().str))
          return false;
 
-      auto macro = macros.find(*itr);
+      auto macro = macros.find(buf.back());
       if(!macro) return false;
 
+      call.clear();
+      call.push_back(getNext());
+
+      Rng argRng;
+
       // Function-like macro.
       if(macro->func)
       {
-         auto first = itr++;
-
          // Search for opening parenthesis.
-         for(;; ++itr)
+         for(;;)
          {
-            if(itr == buf.end()) {buf.emplace(itr, src.get()); --itr;}
+            call.push_back(getNext());
+
+            auto const &tok = call.back();
 
-            if(itr->tok == Core::TOK_WSpace || itr->tok == Core::TOK_LnEnd) continue;
-            if(itr->tok == Core::TOK_Marker) {applyMarker(itr->str); buf.erase(itr++); --itr; continue;}
-            if(itr->tok == Core::TOK_ParenO) break;
+            if(tok.tok == Core::TOK_WSpace || tok.tok == Core::TOK_LnEnd) continue;
+            if(tok.tok == Core::TOK_Marker) {applyMarker(tok.str); call.pop_back(); continue;}
+            if(tok.tok == Core::TOK_ParenO) break;
 
+            // Not an invocation, so put the tokens back.
+            buf.insert(buf.end(), call.rbegin(), call.rend());
             return false;
          }
 
-         auto argFirst = itr++;
+         auto argFirst = call.size();
 
          // Search for closing parenthesis.
-         for(std::size_t depth = 0;; ++itr)
+         for(std::size_t depth = 0;;)
          {
-            if(itr == buf.end()) {buf.emplace(itr, src.get()); --itr;}
+            call.push_back(getNext());
 
-            if(itr->tok == Core::TOK_Marker) {applyMarker(itr->str); buf.erase(itr++); --itr; continue;}
-            if(itr->tok == Core::TOK_ParenO) ++depth;
-            if(itr->tok == Core::TOK_ParenC) {if(depth) --depth; else break;}
+            auto const &tok = call.back();
 
-            if(itr->tok == Core::TOK_EOF)
-               Core::Error(first->pos, "unterminated macro call");
-         }
+            if(tok.tok == Core::TOK_Marker) {applyMarker(tok.str); call.pop_back(); continue;}
+            if(tok.tok == Core::TOK_ParenO) ++depth;
+            if(tok.tok == Core::TOK_ParenC) {if(depth) --depth; else break;}
 
-         auto argLast = itr++; ++argFirst;
-
-         buf.emplace(first, first->pos, first->str, Core::TOK_Marker);
-
-         expand(first, *macro, Core::MakeRange(argFirst, argLast));
-
-         buf.emplace(first, first->pos, first->str, Core::TOK_Marker);
+            if(tok.tok == Core::TOK_EOF)
+               Core::Error(call.front().pos, "unterminated macro call");
+         }
 
-         buf.erase(first, itr);
+         argRng = {call.data() + argFirst, call.data() + call.size() - 1};
       }
 
       // Object-like macro.
       else
-      {
-         buf.emplace(itr, itr->pos, itr->str, Core::TOK_Marker);
+         argRng = {call.data() + 1, call.data() + 1};
 
-         expand(itr, *macro, Core::MakeRange(itr, itr));
+      auto const &name = call.front();
 
-         buf.emplace(itr, itr->pos, itr->str, Core::TOK_Marker);
+      out.clear();
+      out.emplace_back(name.pos, name.str, Core::TOK_Marker);
 
-         buf.erase(itr);
-      }
+      expand(*macro, name.pos, argRng);
+
+      out.emplace_back(name.pos, name.str, Core::TOK_Marker);
+
+      buf.insert(buf.end(), out.rbegin(), out.rend());
 
       return true;
    }
@@ -257,122 +183,253 @@ namespace GDCC::CPP
    //
    // MacroTBuf::expand
    //
-   void MacroTBuf::expand(Itr e, Macro const &macro, Rng const &argRng)
+   void MacroTBuf::expand(Macro const &macro, Core::OriginCode pos, Rng const &argRng)
    {
-      auto argv = MakeArgs(macro, argRng);
+      makeArgs(macro, argRng);
 
       for(auto itr = macro.list.begin(), end = macro.list.end(); itr != end; ++itr)
       {
          // # operator
          if(itr->tok == Core::TOK_Hash && macro.func)
          {
-            Rng const *arg;
+            Arg *arg;
 
             while(itr + 1 != end &&
                (itr[1].tok == Core::TOK_WSpace || itr[1].tok == Core::TOK_LnEnd))
                ++itr;
 
-            if(itr + 1 == end || !(arg = FindArg(itr[1], macro, argv, vaArgStr)))
-               Core::Error(e->pos, "# not followed by arg");
+            if(itr + 1 == end || !(arg = findArg(itr[1], macro)))
+               Core::Error(pos, "# not followed by arg");
 
-            buf.emplace(e, e->pos, stringize(*arg), Core::TOK_String);
+            out.emplace_back(pos, stringize(arg->rng), Core::TOK_String);
             ++itr;
          }
 
          // ## operator
          else if(itr->tok == Core::TOK_Hash2)
          {
-            if((++itr)->tok == Core::TOK_WSpace) ++itr;
+            if(++itr != end && itr->tok == Core::TOK_WSpace) ++itr;
+
+            if(itr == end)
+               Core::Error(pos, "## at end of macro");
 
             // Search backwards for token to concatenate to.
-            auto tok = e; --tok;
-            for(;; --tok)
+            auto tok = out.size();
+            do
             {
-               if(tok->tok == Core::TOK_WSpace || tok->tok == Core::TOK_LnEnd) continue;
-               if(tok->tok == Core::TOK_Marker && tok->str) continue;
+               if(!tok)
+                  Core::Error(pos, "## at start of macro");
 
-               break;
+               --tok;
             }
+            while(out[tok].tok == Core::TOK_WSpace || out[tok].tok == Core::TOK_LnEnd ||
+               (out[tok].tok == Core::TOK_Marker && out[tok].str));
 
-            if(auto arg = FindArg(*itr, macro, argv, vaArgStr))
+            if(auto arg = findArg(*itr, macro))
             {
-               auto argItr = arg->begin(), argEnd = arg->end();
+               auto argItr = arg->rng.begin(), argEnd = arg->rng.end();
 
                // Search for token to concatenate from.
-               for(;; ++argItr)
+               for(; argItr != argEnd; ++argItr)
                {
                   if(argItr->tok == Core::TOK_WSpace || argItr->tok == Core::TOK_LnEnd)
                      continue;
                   if(argItr->tok == Core::TOK_Marker && argItr->str)
-                     {buf.emplace(e, *argItr); continue;}
+                     {out.push_back(*argItr); continue;}
 
                   break;
                }
 
                if(argItr != argEnd)
                {
-                  *tok = Macro::Concat(*tok, *argItr++);
+                  out[tok] = Macro::Concat(out[tok], *argItr++);
 
                   for(; argItr != argEnd; ++argItr)
-                     buf.emplace(e, e->pos, argItr->str, argItr->tok);
+                     out.emplace_back(pos, argItr->str, argItr->tok);
                }
             }
             else
-               *tok = Macro::Concat(*tok, *itr);
+               out[tok] = Macro::Concat(out[tok], *itr);
          }
 
          // Argument substitution.
-         else if(auto arg = FindArg(*itr, macro, argv, vaArgStr))
+         else if(auto arg = findArg(*itr, macro))
          {
             if(IsConcat(itr, macro))
             {
-               if(IsEmpty(*arg))
-                  buf.emplace(e, e->pos, Core::STRNULL, Core::TOK_Marker);
+               if(IsEmpty(arg->rng))
+                  out.emplace_back(pos, Core::STRNULL, Core::TOK_Marker);
 
-               else for(auto const &argTok : *arg)
-                  buf.emplace(e, e->pos, argTok.str, argTok.tok);
+               else for(auto const &argTok : arg->rng)
+                  out.emplace_back(pos, argTok.str, argTok.tok);
             }
             else
             {
                // Mark start of fully expanded tokens.
-               auto eTmp = buf.emplace(e, e->pos, Core::STR_TOK_Add, Core::TOK_Marker);
+               out.emplace_back(pos, Core::STR_TOK_Add, Core::TOK_Marker);
+
+               auto const &exp = expandArg(*arg, pos);
+               out.insert(out.end(), exp.begin(), exp.end());
+
+               // Mark end-1 of fully expanded tokens.
+               out.emplace(exp.empty() ? out.end() : out.end() - 1,
+                  pos, Core::STR_TOK_Sub, Core::TOK_Marker);
+            }
+         }
+
+         // Drop whitespace preceding a ##.
+         else if(itr->tok != Core::TOK_WSpace || !IsConcat(itr, macro))
+            out.emplace_back(pos, itr->str, itr->tok);
+      }
+   }
+
+   //
+   // MacroTBuf::expandArg
+   //
+   std::vector<Core::Token> const &MacroTBuf::expandArg(Arg &arg, Core::OriginCode pos)
+   {
+      if(arg.expDone) return arg.exp;
 
-               // Use temporary buffer to fully expand argument.
+      // Use another buffer to fully expand argument.
+      if(!argBuf)
+         argBuf.reset(new MacroTBuf{argSrc, macros, vaArgStr});
+      else
+         argBuf->reset();
 
-               std::vector<Core::Token> toks; toks.reserve(arg->size());
+      tmp.clear();
+      for(auto const &argTok : arg.rng)
+         tmp.emplace_back(pos, argTok.str, argTok.tok);
 
-               // Add tokens.
-               for(auto const &argTok : *arg)
-                  toks.emplace_back(e->pos, argTok.str, argTok.tok);
+      argSrc = Core::ArrayTBuf{tmp.data(), tmp.size()};
 
-               // Build token buffer.
-               Core::ArrayTBuf abuf{toks.data(), toks.size()};
-               MacroTBuf mbuf{abuf, macros};
+      arg.exp.clear();
+      while(argBuf->peek().tok != Core::TOK_EOF)
+         arg.exp.push_back(argBuf->get());
 
-               // Read from buffer.
-               while(mbuf.peek().tok != Core::TOK_EOF)
-                  buf.emplace(e, mbuf.get());
+      arg.expDone = true;
+      return arg.exp;
+   }
 
-               // Mark end-1 of fully expanded tokens.
-               if(++eTmp != e) --(eTmp = e);
-               buf.emplace(eTmp, e->pos, Core::STR_TOK_Sub, Core::TOK_Marker);
+   //
+   // MacroTBuf::findArg
+   //
+   MacroTBuf::Arg *MacroTBuf::findArg(Core::Token const &tok, Macro const &macro)
+   {
+      if(tok.tok != Core::TOK_Identi) return nullptr;
+
+      if(tok.str == vaArgStr && !macro.args.empty() && !macro.args.back())
+         return &argv[macro.args.size() - 1];
+
+      for(auto itr = macro.args.begin(), end = macro.args.end(); itr != end; ++itr)
+      {
+         if(tok.str == *itr)
+            return &argv[itr - macro.args.begin()];
+      }
+
+      return nullptr;
+   }
+
+   //
+   // MacroTBuf::getNext
+   //
+   // Takes the next pending token, reading from src if there are none.
+   //
+   Core::Token MacroTBuf::getNext()
+   {
+      if(buf.empty()) return src.get();
+
+      auto tok = buf.back();
+      buf.pop_back();
+      return tok;
+   }
+
+   //
+   // MacroTBuf::isIgnore
+   //
+   bool MacroTBuf::isIgnore(Core::String name) const
+   {
+      return std::find(ignore.begin(), ignore.end(), name) != ignore.end();
+   }
+
+   //
+   // MacroTBuf::makeArgs
+   //
+   // Builds argument token ranges, if any.
+   //
+   void MacroTBuf::makeArgs(Macro const &macro, Rng const &argRng)
+   {
+      if(macro.args.empty())
+      {
+         if(!IsEmpty(argRng))
+            Core::Error(argRng.begin()->pos, "args to no-arg macro");
+
+         return;
+      }
+
+      // Only grow argv, to keep the expansion buffers of unused elements.
+      if(argv.size() < macro.args.size())
+         argv.resize(macro.args.size());
+
+      auto argi = argv.begin(), arge = argi + macro.args.size();
+
+      for(auto itr = argi; itr != arge; ++itr)
+         itr->expDone = false;
+
+      argi->rng.first = argRng.first;
+
+      std::size_t depth = 0;
+      for(auto itr = argRng.begin(), end = argRng.end(); itr != end;)
+      {
+            if(itr->tok == Core::TOK_ParenO) ++depth;
+         else if(itr->tok == Core::TOK_ParenC) --depth;
+         else if(itr->tok == Core::TOK_Comma && !depth)
+         {
+            if(argi + 1 == arge)
+            {
+               if(macro.args.back())
+                  Core::Error(itr->pos, "too many macro args");
+               else
+                  break;
             }
+
+            argi++->rng.last = itr++;
+            argi->rng.first = itr;
+
+            continue;
          }
 
-         // Drop whitespace preceding a ##.
-         else if(itr->tok != Core::TOK_WSpace || !IsConcat(itr, macro))
-            buf.emplace(e, e->pos, itr->str, itr->tok);
+         ++itr;
+      }
+
+      argi->rng.last = argRng.last;
+
+      if(argi + 1 != arge)
+      {
+         if(macro.args.back() || argi + 2 != arge)
+            Core::Error(argRng.begin()->pos, "not enough macro args");
+
+         (++argi)->rng = {argRng.end(), argRng.end()};
       }
    }
 
+   //
+   // MacroTBuf::reset
+   //
+   void MacroTBuf::reset()
+   {
+      buf.clear();
+      ignore.clear();
+      ignoreAll = false;
+
+      sett(nullptr, nullptr, nullptr);
+   }
+
    //
    // MacroTBuf::stringize
    //
    Core::String MacroTBuf::stringize(Rng const &arg)
    {
-      std::string tmp;
-
-      tmp += '"';
+      str.assign(1, '"');
 
       auto itr = arg.begin(), end = arg.end();
 
@@ -382,14 +439,14 @@ namespace GDCC::CPP
 
       // Stringize tokens.
       for(; itr != end; ++itr)
-         Macro::Stringize(tmp, *itr);
+         Macro::Stringize(str, *itr);
 
       // Discard trailing whitespace.
-      while(std::isspace(tmp.back())) tmp.pop_back();
+      while(std::isspace(str.back())) str.pop_back();
 
-      tmp += '"';
+      str += '"';
 
-      return {tmp.data(), tmp.size()};
+      return {str.data(), str.size()};
    }
 
    //
@@ -399,14 +456,11 @@ namespace GDCC::CPP
    {
       if(tptr() != tend()) return;
 
-      if(!buf.empty()) buf.pop_front();
+      if(!buf.empty()) buf.pop_back();
 
-      while(expand(buf.begin())) {}
+      while(expand()) {}
 
-      if(buf.empty())
-         sett(nullptr, nullptr, nullptr);
-      else
-         sett(&buf.front(), &buf.front(), &buf.front() + 1);
+      sett(&buf.back(), &buf.back(), &buf.back() + 1);
    }
 }
 
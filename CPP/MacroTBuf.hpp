@@ -18,8 +18,9 @@
 #include "../Core/TokenBuf.hpp"
 #include "../Core/Range.hpp"
 
-#include <list>
-#include <unordered_set>
+#include <memory>
+#include <string>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -31,10 +32,14 @@ namespace GDCC::CPP
    //
    // MacroTBuf
    //
+   // Pending tokens are kept in reverse order, so that tokens are taken from
+   // the back and expansions are pushed onto it. Tokens are otherwise copied
+   // into reused buffers, so expanding a macro does not usually allocate.
+   //
    class MacroTBuf : public Core::TokenBuf
    {
    public:
-      using Itr = std::list<Core::Token>::iterator;
+      using Itr = Core::Token const *;
       using Rng = Core::Range<Itr>;
 
 
@@ -42,18 +47,52 @@ namespace GDCC::CPP
          Core::String vaArgStr = Core::STR___VA_ARGS__);
 
    protected:
+      //
+      // Arg
+      //
+      class Arg
+      {
+      public:
+         Rng                      rng;
+         std::vector<Core::Token> exp;
+         bool                     expDone;
+      };
+
+
       void applyMarker(Core::String str);
 
-      bool expand(Itr itr);
-      void expand(Itr end, Macro const &macro, Rng const &argRng);
+      bool expand();
+      void expand(Macro const &macro, Core::OriginCode pos, Rng const &argRng);
+
+      // Returns the fully expanded tokens of an argument, which are only
+      // computed once per expansion.
+      std::vector<Core::Token> const &expandArg(Arg &arg, Core::OriginCode pos);
+
+      Arg *findArg(Core::Token const &tok, Macro const &macro);
+
+      Core::Token getNext();
+
+      bool isIgnore(Core::String str) const;
+
+      void makeArgs(Macro const &macro, Rng const &argRng);
+
+      void reset();
 
       Core::String stringize(Rng const &arg);
 
       virtual void underflow();
 
-      std::list<Core::Token> buf;
+      std::vector<Core::Token> buf;
+      std::vector<Core::Token> call;
+      std::vector<Core::Token> out;
+      std::vector<Core::Token> tmp;
+      std::vector<Arg>         argv;
+      std::string              str;
+
+      std::vector<Core::String> ignore;
 
-      std::unordered_set<Core::String> ignore;
+      Core::ArrayTBuf            argSrc;
+      std::unique_ptr<MacroTBuf> argBuf;
 
       MacroMap       &macros;
       Core::TokenBuf &src;
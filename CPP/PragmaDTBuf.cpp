@@ -88,7 +88,7 @@ namespace GDCC::CPP
       while((buf[0] = src.get()).tok == Core::TOK_Identi &&
          buf[0].str == Core::STR__Pragma)
       {
-         auto pos = buf[0].pos;
+         Core::Origin pos = buf[0].pos;
 
          // <_Pragma> ( string-literal )
          if(skipWS().tok != Core::TOK_ParenO ||
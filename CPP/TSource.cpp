@@ -333,6 +333,87 @@ namespace GDCC::CPP
       return tok;
    }
 
+   //
+   // TSource::v_skipGroup
+   //
+   // Scans for a # or %: at the start of a line, leaving it to be read as a
+   // token. Only comments and literals need to be recognized to find it.
+   //
+   void TSource::v_skipGroup()
+   {
+      auto &buf  = *in.rdbuf();
+      bool  endl = true;
+
+      for(int c; (c = buf.sgetc()) != EOF;)
+      {
+         switch(c)
+         {
+         case '\n':
+            endl = true;
+            break;
+
+         case '#':
+            if(endl) return;
+            break;
+
+         case '%':
+            // %: digraph.
+            if(endl)
+            {
+               buf.sbumpc();
+               c = buf.sgetc();
+               buf.sungetc();
+               if(c == ':') return;
+            }
+            endl = false;
+            break;
+
+         case '/':
+            buf.sbumpc();
+
+            // Block comment.
+            if(buf.sgetc() == '*')
+            {
+               buf.sbumpc();
+               for(int o = EOF; (c = buf.sbumpc()) != EOF && !(o == '*' && c == '/'); o = c) {}
+            }
+
+            // Line comment.
+            else if(buf.sgetc() == '/')
+            {
+               while((c = buf.sgetc()) != EOF && c != '\n') buf.sbumpc();
+            }
+
+            else
+               endl = false;
+
+            continue;
+
+         case '"':
+         case '\'':
+            // Unterminated literals end at the end of the line, as they are
+            // not diagnosed in skipped groups.
+            for(int term = buf.sbumpc(); (c = buf.sgetc()) != EOF && c != '\n';)
+            {
+               buf.sbumpc();
+
+               if(c == term) break;
+
+               if(c == '\\' && buf.sgetc() != '\n') buf.sbumpc();
+            }
+
+            endl = false;
+            continue;
+
+         default:
+            if(!std::isspace(static_cast<unsigned char>(c))) endl = false;
+            break;
+         }
+
+         buf.sbumpc();
+      }
+   }
+
    //
    // TSource::SkipCommentB
    //
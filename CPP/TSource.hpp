@@ -45,6 +45,8 @@ namespace GDCC::CPP
 
       virtual Core::Token v_getToken();
 
+      virtual void v_skipGroup();
+
       std::istream       &in;
       Core::OriginSource &orig;
 
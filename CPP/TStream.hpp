@@ -47,7 +47,7 @@ namespace GDCC::CPP
          PragmaDataBase &pragd, PragmaParserBase &pragp, Core::String dir) :
          Core::TokenStream{&udir},
          tbuf{tsrc},
-         cdir{tbuf, macros},
+         cdir{tbuf, tsrc, macros},
          ddir{cdir, macros},
          edir{ddir},
          idir{edir, tsrc, langs, macros, pragd, pragp, dir},
@@ -28,6 +28,12 @@ namespace GDCC::CPP
    class DefinedTBuf;
    class DirectiveTBuf;
    class ErrorDTBuf;
+   class HeaderEvent;
+   class HeaderPragma;
+   class HeaderRecord;
+   class HeaderStream;
+   class HeaderTBuf;
+   class HeaderTable;
    class IStream;
    class IdentiTBuf;
    class IncStream;
@@ -35,6 +41,7 @@ namespace GDCC::CPP
    class IncludeLang;
    class LineDTBuf;
    class Macro;
+   class MacroLog;
    class MacroMap;
    class MacroTBuf;
    class PPStream;
@@ -15,11 +15,69 @@
 #include "CPP/TStream.hpp"
 #include "CPP/TSource.hpp"
 
+#include "Core/Exception.hpp"
 #include "Core/File.hpp"
 #include "Core/Option.hpp"
 #include "Core/Path.hpp"
 
+#include "Option/CStr.hpp"
+#include "Option/Int.hpp"
+
+#include <cstring>
 #include <iostream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+//
+// --batch
+//
+static GDCC::Option::CStr BatchList
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("batch")
+      .setGroup("input")
+      .setDescS("Preprocesses a list of input and output files.")
+      .setDescL("Preprocesses a list of input and output files. Each line of "
+         "the named file has an input name followed by an output name, "
+         "separated by whitespace. Each input is preprocessed on its own, "
+         "exactly as if it were the only input. Jobs are split between "
+         "--jobs worker processes.")
+};
+
+//
+// -j, --jobs
+//
+static GDCC::Option::Int<std::size_t> BatchJobs
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("jobs").setName('j')
+      .setGroup("input")
+      .setDescS("Sets the number of --batch workers. Default: processors"),
+
+   0
+};
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+//
+// BatchJob
+//
+using BatchJob = std::pair<std::string, std::string>;
 
 
 //----------------------------------------------------------------------------|
@@ -29,20 +87,147 @@
 static void ProcessFile(std::ostream &out, char const *inName);
 static void PutStringEscape(std::ostream &out, GDCC::Core::String str);
 
+//
+// RunBatch
+//
+// Runs every step-th job starting with first. Returns false if any failed.
+//
+static bool RunBatch(std::vector<BatchJob> const &jobs, std::size_t first,
+   std::size_t step)
+{
+   bool res = true;
+
+   for(auto i = first; i < jobs.size(); i += step) try
+   {
+      GDCC::Core::FileDepends deps;
+
+      {
+         auto buf = GDCC::Core::FileOpenStream(jobs[i].second.data(), std::ios_base::out);
+         std::ostream out{buf.get()};
+         ProcessFile(out, jobs[i].first.data());
+      }
+
+      GDCC::Core::PutOptionDepends(deps, jobs[i].second.data());
+   }
+   catch(std::exception const &e)
+   {
+      std::cerr << "ERROR: " << e.what() << std::endl;
+      res = false;
+   }
+   catch(int)
+   {
+      res = false;
+   }
+
+   return res;
+}
+
+//
+// RunBatchWorkers
+//
+// Workers are processes, as the string table cannot be shared by threads.
+// Each takes every Nth job, so that it can reuse the headers cached by its
+// previous jobs. State set up before starting them, such as options, is
+// shared by all of them.
+//
+static bool RunBatchWorkers(std::vector<BatchJob> const &jobs, std::size_t workers)
+{
+   #ifdef _WIN32
+   return RunBatch(jobs, 0, 1);
+   #else
+   if(workers <= 1)
+      return RunBatch(jobs, 0, 1);
+
+   std::vector<pid_t> pids;
+   bool               res = true;
+
+   std::cout.flush();
+   std::cerr.flush();
+
+   for(std::size_t i = 0; i != workers; ++i)
+   {
+      pid_t pid = fork();
+
+      if(pid == 0)
+      {
+         bool ok = RunBatch(jobs, i, workers);
+
+         // Jobs can write to standard output, which _exit does not flush.
+         std::cout.flush();
+         std::cerr.flush();
+         _exit(ok ? EXIT_SUCCESS : EXIT_FAILURE);
+      }
+
+      // If unable to start a worker, do its jobs here instead.
+      if(pid < 0)
+         res = RunBatch(jobs, i, workers) && res;
+      else
+         pids.push_back(pid);
+   }
+
+   for(auto pid : pids)
+   {
+      int status;
+      if(waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) ||
+         WEXITSTATUS(status) != EXIT_SUCCESS)
+         res = false;
+   }
+
+   return res;
+   #endif
+}
+
+//
+// MakeBatch
+//
+static void MakeBatch()
+{
+   std::vector<BatchJob> jobs;
+
+   // Each job writes its own dependency file, named after its output.
+   if(GDCC::Core::GetOptions().optDepsFile.data())
+      GDCC::Core::Error({}, "--deps-file cannot be used with --batch");
+
+   // Read job list.
+   {
+      auto buf = GDCC::Core::FileOpenStream(BatchList, std::ios_base::in);
+      std::istream in{buf.get()};
+
+      for(BatchJob job; in >> job.first >> job.second;)
+         jobs.push_back(std::move(job));
+   }
+
+   std::size_t workers = BatchJobs ? BatchJobs : std::thread::hardware_concurrency();
+   if(workers > jobs.size()) workers = jobs.size();
+
+   if(!RunBatchWorkers(jobs, workers))
+      throw EXIT_FAILURE;
+}
+
 //
 // MakeCPP
 //
 static void MakeCPP()
 {
-   auto outName = GDCC::Core::GetOptionOutput();
+   if(BatchList.data())
+      return MakeBatch();
 
-   // Open output file.
-   auto buf = GDCC::Core::FileOpenStream(outName, std::ios_base::out);
+   GDCC::Core::ProcessOptionOutput(GDCC::Core::GetOptions());
 
-   // Process inputs.
-   std::ostream out{buf.get()};
-   for(auto const &arg : GDCC::Core::GetOptionArgs())
-      ProcessFile(out, arg);
+   auto                    outName = GDCC::Core::GetOptionOutput();
+   GDCC::Core::FileDepends deps;
+
+   {
+      // Open output file.
+      auto buf = GDCC::Core::FileOpenStream(outName, std::ios_base::out);
+
+      // Process inputs.
+      std::ostream out{buf.get()};
+      for(auto const &arg : GDCC::Core::GetOptionArgs())
+         ProcessFile(out, arg);
+   }
+
+   GDCC::Core::PutOptionDepends(deps, outName);
 }
 
 //
@@ -50,7 +235,9 @@ static void MakeCPP()
 //
 static void ProcessFile(std::ostream &out, char const *inName)
 {
-   auto buf = GDCC::Core::FileOpenStream(inName, std::ios_base::in);
+   auto buf = GDCC::Core::FileOpenSource(inName);
+   if(std::strcmp(inName, "-"))
+      GDCC::Core::FileDepends::Add(inName, std::strlen(inName));
 
    GDCC::Core::String      file {inName};
    GDCC::CPP::IncludeLang  langs{"C"};
@@ -116,7 +303,8 @@ static void PutStringEscape(std::ostream &out, GDCC::Core::String str)
 //
 int main(int argc, char *argv[])
 {
-   auto &list = GDCC::Core::GetOptionList();
+   auto &opts = GDCC::Core::GetOptions();
+   auto &list = opts.list;
 
    list.name     = "gdcc-cpp";
    list.nameFull = "GDCC C Preprocessor";
@@ -126,9 +314,13 @@ int main(int argc, char *argv[])
    list.descS =
       "Performs C preprocessing. Output defaults to last loose argument.";
 
+   opts.optDeps.insert(&list);
+   opts.optDepsFile.insert(&list);
+   opts.optDepsPhony.insert(&list);
+
    try
    {
-      GDCC::Core::ProcessOptions(GDCC::Core::GetOptions(), argc, argv);
+      GDCC::Core::ProcessOptions(opts, argc, argv, false);
       MakeCPP();
    }
    catch(std::exception const &e)
@@ -14,10 +14,11 @@
 
 #include "Core/Exception.hpp"
 #include "Core/String.hpp"
+#include "Core/StringBuf.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
-#include <vector>
 
 #include <sys/stat.h>
 
@@ -79,6 +80,43 @@ namespace GDCC::Core
 }
 
 
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   FileDepends *FileDepends::Head = nullptr;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // FilePutDepend
+   //
+   // Writes a file name for a Make rule, escaping characters that Make and
+   // Ninja would otherwise interpret.
+   //
+   static std::ostream &FilePutDepend(std::ostream &out, char const *name)
+   {
+      for(; *name; ++name) switch(*name)
+      {
+      case ' ':  out << "\\ "; break;
+      case '#':  out << "\\#"; break;
+      case '$':  out << "$$";  break;
+      default:   out << *name; break;
+      }
+
+      return out;
+   }
+}
+
+
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
 //
@@ -86,91 +124,105 @@ namespace GDCC::Core
 namespace GDCC::Core
 {
    //
-   // FileBlock::getHash
+   // FileDepends constructor
    //
-   std::size_t FileBlock::getHash() const
+   FileDepends::FileDepends() : prev{Head}
    {
-      if(!cacheHash)
-         cacheHash = StrHash(data(), size());
+      Head = this;
+   }
 
-      return cacheHash;
+   //
+   // FileDepends destructor
+   //
+   FileDepends::~FileDepends()
+   {
+      Head = prev;
    }
 
    //
-   // FileOpenBlock
+   // FileDepends::Add
    //
-   std::unique_ptr<FileBlock> FileOpenBlock(char const *filename)
+   void FileDepends::Add(char const *filename, std::size_t len)
    {
-      // Special file: -
-      if(filename[0] == '-' && filename[1] == '\0')
+      for(auto deps = Head; deps; deps = deps->prev)
       {
-         std::vector<char> buf;
-         for(char c; std::cin >> c;)
-            buf.emplace_back(c);
-
-         auto data = StrDup(buf.data(), buf.size());
-         return {new FileBlock_Buffer(data.release(), buf.size()), {}};
+         auto &files = deps->files;
+         if(std::find(files.begin(), files.end(), std::string{filename, len}) == files.end())
+            files.emplace_back(filename, len);
       }
+   }
 
-      struct stat statBuf;
-
-      #ifdef _WIN32
-      std::FILE *file;
-
-      if(stat(filename, &statBuf) || !S_ISREG(statBuf.st_mode))
-         ErrorFile(filename, "reading");
+   //
+   // FileDepends::AddAbsent
+   //
+   void FileDepends::AddAbsent(char const *filename, std::size_t len)
+   {
+      for(auto deps = Head; deps; deps = deps->prev)
+      {
+         auto &files = deps->absent;
+         if(std::find(files.begin(), files.end(), std::string{filename, len}) == files.end())
+            files.emplace_back(filename, len);
+      }
+   }
 
-      if(!(file = std::fopen(filename, "rb")))
-         ErrorFile(filename, "reading");
+   //
+   // FileDepends::SetSpecial
+   //
+   void FileDepends::SetSpecial()
+   {
+      for(auto deps = Head; deps; deps = deps->prev)
+         deps->special = true;
+   }
 
-      // Allocate storage.
-      std::unique_ptr<char[]> data{new char[statBuf.st_size]};
+   //
+   // FileDepends::put
+   //
+   void FileDepends::put(std::ostream &out, char const *target, bool phony) const
+   {
+      FilePutDepend(out, target);
+      out << ':';
 
-      // Read data.
-      if(!std::fread(data.get(), statBuf.st_size, 1, file))
-         std::fclose(file), ErrorFile(filename, "reading");
+      for(auto const &file : files)
+         FilePutDepend(out << " \\\n ", file.data());
 
-      std::fclose(file);
+      out << '\n';
 
-      return {new FileBlock_Buffer(data.release(), statBuf.st_size), {}};
-      #else
-      // Attempt to memory map the file.
-      // POSIX indicates that this can be expected to fail for non-file reasons.
-      // Therefore, a read fallback is provided.
-      int fd;
-
-      // Open file.
-      if((fd = open(filename, O_RDONLY)) == -1)
-         ErrorFile(filename, "reading");
-
-      // Stat file.
-      if(fstat(fd, &statBuf) || !S_ISREG(statBuf.st_mode))
-         close(fd), ErrorFile(filename, "reading");
+      if(phony) for(auto const &file : files)
+         FilePutDepend(out << '\n', file.data()) << ":\n";
+   }
 
-      // Map file.
-      auto map = mmap(nullptr, statBuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   //
+   // FileBlock::getHash
+   //
+   std::size_t FileBlock::getHash() const
+   {
+      if(!cacheHash)
+         cacheHash = StrHash(data(), size());
 
-      if(map == MAP_FAILED)
-      {
-         // Fall back to read instead.
-         std::unique_ptr<char[]> data{new char[statBuf.st_size]};
+      return cacheHash;
+   }
 
-         // Read data.
-         if(read(fd, data.get(), statBuf.st_size) == -1)
-            close(fd), ErrorFile(filename, "reading");
+   //
+   // FileOpenBlock
+   //
+   std::unique_ptr<FileBlock> FileOpenBlock(char const *filename)
+   {
+      if(auto block = FileTryBlock(filename))
+         return block;
 
-         close(fd);
+      ErrorFile(filename, "reading");
+   }
 
-         return {new FileBlock_Buffer(data.release(), statBuf.st_size), {}};
-      }
-      else
-      {
-         close(fd);
+   //
+   // FileOpenSource
+   //
+   std::unique_ptr<std::streambuf, ConditionalDeleter<std::streambuf>>
+   FileOpenSource(char const *filename)
+   {
+      if(filename[0] == '-' && filename[1] == '\0')
+         return FileOpenStream(filename, std::ios_base::in);
 
-         auto data = static_cast<char *>(map);
-         return {new FileBlock_Mapped(data, statBuf.st_size), {}};
-      }
-      #endif
+      return {new StringBuf{FileOpenBlock(filename)}, true};
    }
 
    //
@@ -229,6 +281,83 @@ namespace GDCC::Core
 
       return statBuf.st_size;
    }
+
+   //
+   // FileTryBlock
+   //
+   std::unique_ptr<FileBlock> FileTryBlock(char const *filename)
+   {
+      // Special file: -
+      if(filename[0] == '-' && filename[1] == '\0')
+      {
+         std::vector<char> buf;
+         for(char c; std::cin >> c;)
+            buf.emplace_back(c);
+
+         auto data = StrDup(buf.data(), buf.size());
+         return {new FileBlock_Buffer(data.release(), buf.size()), {}};
+      }
+
+      struct stat statBuf;
+
+      #ifdef _WIN32
+      std::FILE *file;
+
+      if(stat(filename, &statBuf) || !S_ISREG(statBuf.st_mode))
+         return nullptr;
+
+      if(!(file = std::fopen(filename, "rb")))
+         return nullptr;
+
+      // Allocate storage.
+      std::unique_ptr<char[]> data{new char[statBuf.st_size]};
+
+      // Read data.
+      if(!std::fread(data.get(), statBuf.st_size, 1, file))
+         return std::fclose(file), nullptr;
+
+      std::fclose(file);
+
+      return {new FileBlock_Buffer(data.release(), statBuf.st_size), {}};
+      #else
+      // Attempt to memory map the file.
+      // POSIX indicates that this can be expected to fail for non-file reasons.
+      // Therefore, a read fallback is provided.
+      int fd;
+
+      // Open file.
+      if((fd = open(filename, O_RDONLY)) == -1)
+         return nullptr;
+
+      // Stat file.
+      if(fstat(fd, &statBuf) || !S_ISREG(statBuf.st_mode))
+         return close(fd), nullptr;
+
+      // Map file.
+      auto map = mmap(nullptr, statBuf.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if(map == MAP_FAILED)
+      {
+         // Fall back to read instead.
+         std::unique_ptr<char[]> data{new char[statBuf.st_size]};
+
+         // Read data.
+         if(read(fd, data.get(), statBuf.st_size) == -1)
+            return close(fd), nullptr;
+
+         close(fd);
+
+         return {new FileBlock_Buffer(data.release(), statBuf.st_size), {}};
+      }
+      else
+      {
+         close(fd);
+
+         auto data = static_cast<char *>(map);
+         return {new FileBlock_Mapped(data, statBuf.st_size), {}};
+      }
+      #endif
+   }
 }
 
 // EOF
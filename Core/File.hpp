@@ -16,7 +16,10 @@
 #include "../Core/Deleter.hpp"
 
 #include <memory>
+#include <ostream>
 #include <streambuf>
+#include <string>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -51,6 +54,49 @@ namespace GDCC::Core
    private:
       mutable std::size_t cacheHash = 0;
    };
+
+   //
+   // FileDepends
+   //
+   // While in scope, collects the names of files read as additional input,
+   // such as included headers.
+   //
+   class FileDepends
+   {
+   public:
+      FileDepends();
+      FileDepends(FileDepends const &) = delete;
+      ~FileDepends();
+
+      FileDepends &operator = (FileDepends const &) = delete;
+
+      // Writes a Make rule for target depending on the collected files. If
+      // phony is true, an empty rule is also written for each file, so that
+      // removing one does not stop Make.
+      void put(std::ostream &out, char const *target, bool phony) const;
+
+      std::vector<std::string> files;
+
+      // Files looked for but not found, such as a header in the include
+      // directories searched before the one it was found in.
+      std::vector<std::string> absent;
+
+      // Set if what was read depends on more than the files, such as by
+      // expanding __DATE__ or __TIME__.
+      bool special = false;
+
+
+      static void Add(char const *filename, std::size_t len);
+
+      static void AddAbsent(char const *filename, std::size_t len);
+
+      static void SetSpecial();
+
+   private:
+      FileDepends *prev;
+
+      static FileDepends *Head;
+   };
 }
 
 
@@ -62,10 +108,18 @@ namespace GDCC::Core
 {
    std::unique_ptr<FileBlock> FileOpenBlock(char const *filename);
 
+   // Opens a source file for reading. Standard input is read as a stream,
+   // since blocks read it as text. Other files are read whole.
+   std::unique_ptr<std::streambuf, ConditionalDeleter<std::streambuf>>
+   FileOpenSource(char const *filename);
+
    std::unique_ptr<std::streambuf, ConditionalDeleter<std::streambuf>>
    FileOpenStream(char const *filename, std::ios_base::openmode which);
 
    std::size_t FileSize(char const *filename);
+
+   // Returns null instead of reporting an error.
+   std::unique_ptr<FileBlock> FileTryBlock(char const *filename);
 }
 
 #endif//GDCC__Core__File_H__
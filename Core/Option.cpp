@@ -12,11 +12,13 @@
 
 #include "Core/Option.hpp"
 
+#include "Core/File.hpp"
 #include "Core/Path.hpp"
 
 #include "Option/Exception.hpp"
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 
@@ -82,6 +84,67 @@ namespace GDCC::Core
             {opt->getProgram()->putVersion(std::cout); throw EXIT_SUCCESS;}
       },
 
+      optCacheDir
+      {
+         nullptr, Option::Base::Info()
+            .setName("cache-dir")
+            .setGroup("output")
+            .setDescS("Sets a directory for caching compiled IR.")
+            .setDescL("Sets a directory for caching compiled IR. A source "
+               "is only compiled if the cache has no IR for the same source, "
+               "included files, and command line. Sources using __DATE__ or "
+               "__TIME__ are not cached. The directory is created if it does "
+               "not exist.")
+      },
+
+      optClient
+      {
+         nullptr, Option::Base::Info()
+            .setName("client")
+            .setGroup("server")
+            .setDescS("Sends the compile to a server.")
+            .setDescL("Sends the compile to a server started with --server "
+               "on the given socket, instead of compiling directly. The "
+               "server must have been started with the same options, other "
+               "than inputs and output. Standard input and output cannot be "
+               "used."),
+      },
+
+      optDeps
+      {
+         nullptr, Option::Base::Info()
+            .setName("deps")
+            .setGroup("output")
+            .setDescS("Writes a dependency file.")
+            .setDescL("Writes a Make dependency file listing the sources and "
+               "every file they include or import. The file is named by "
+               "--deps-file, or else by the output with .d added. If output "
+               "is to standard output, --deps-file must be given."),
+
+         false
+      },
+
+      optDepsFile
+      {
+         nullptr, Option::Base::Info()
+            .setName("deps-file")
+            .setGroup("output")
+            .setDescS("Sets the dependency file. Implies --deps.")
+      },
+
+      optDepsPhony
+      {
+         nullptr, Option::Base::Info()
+            .setName("deps-phony")
+            .setGroup("output")
+            .setDescS("Adds an empty rule for each dependency.")
+            .setDescL("Adds an empty rule for each dependency to the "
+               "dependency file, so that Make does not stop with an error "
+               "if one is removed."),
+
+         false
+      },
+
       optLibPath
       {
          nullptr, Option::Base::Info()
@@ -96,13 +159,39 @@ namespace GDCC::Core
                "Default is <system path>/lib.")
       },
 
+      optProgress
+      {
+         nullptr, Option::Base::Info()
+            .setName("progress")
+            .setGroup("output")
+            .setDescS("Writes progress information to stderr."),
+
+         false
+      },
+
+      optServer
+      {
+         nullptr, Option::Base::Info()
+            .setName("server")
+            .setGroup("server")
+            .setDescS("Runs a compile server on a local socket.")
+            .setDescL("Runs a compile server on the given local socket, "
+               "taking compiles from --client until stopped. Headers and "
+               "imports read by one compile are kept for the next. Every "
+               "compile uses the server's options, and so no inputs or "
+               "output are given to the server itself."),
+      },
+
       optSysSource
       {
          nullptr, Option::Base::Info()
             .setName("sys-source")
             .setGroup("input")
             .setDescS("Adds source file from system directory."),
-      }
+      },
+
+      argV{nullptr},
+      argC{0}
    {
       list.processLoose = &args;
    }
@@ -182,6 +271,51 @@ namespace GDCC::Core
       return opts;
    }
 
+   //
+   // PutOptionDepends
+   //
+   void PutOptionDepends(FileDepends const &deps, char const *target)
+   {
+      auto &opts = GetOptions();
+
+      if(!opts.optDeps && !opts.optDepsFile.data())
+         return;
+
+      std::string name;
+      if(opts.optDepsFile.data())
+         name = opts.optDepsFile.data();
+      else
+         name = std::string{target} + ".d";
+
+      auto buf = FileOpenStream(name.data(), std::ios_base::out);
+      std::ostream out{buf.get()};
+      deps.put(out, target, opts.optDepsPhony);
+   }
+
+   //
+   // ProcessOptionOutput
+   //
+   void ProcessOptionOutput(OptionList &opts)
+   {
+      // Default output to last loose arg.
+      if(!opts.optOutput.processed && opts.args.size())
+         opts.args.pop(&opts.optOutput);
+
+      if(!opts.optOutput.processed || !opts.optOutput.data())
+      {
+         std::cerr << "No output specified. Use -h for usage.\n";
+         throw EXIT_FAILURE;
+      }
+
+      // Standard output has no name to derive a dependency file from.
+      if(opts.optDeps && !opts.optDepsFile.data() &&
+         !std::strcmp(opts.optOutput.data(), "-"))
+      {
+         std::cerr << "--deps with standard output needs --deps-file.\n";
+         throw EXIT_FAILURE;
+      }
+   }
+
    //
    // ProcessOptions
    //
@@ -197,13 +331,12 @@ namespace GDCC::Core
          throw EXIT_SUCCESS;
       }
 
+      opts.argV = argv + 1;
+      opts.argC = argc - 1;
+
       try
       {
          opts.list.process(Option::Args().setArgs(argv + 1, argc - 1).setOptKeepA());
-
-         // Default output to last loose arg.
-         if(needOutput && !opts.optOutput.processed && opts.args.size())
-            opts.args.pop(&opts.optOutput);
       }
       catch(Option::Exception const &e)
       {
@@ -211,11 +344,8 @@ namespace GDCC::Core
          throw EXIT_FAILURE;
       }
 
-      if(needOutput && (!opts.optOutput.processed || !opts.optOutput.data()))
-      {
-         std::cerr << "No output specified. Use -h for usage.\n";
-         throw EXIT_FAILURE;
-      }
+      if(needOutput)
+         ProcessOptionOutput(opts);
    }
 }
 
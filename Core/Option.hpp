@@ -15,6 +15,7 @@
 
 #include "../Core/Types.hpp"
 
+#include "../Option/Bool.hpp"
 #include "../Option/CStr.hpp"
 #include "../Option/CStrV.hpp"
 #include "../Option/Function.hpp"
@@ -59,8 +60,19 @@ namespace GDCC::Core
       Option::CStr     optOutput;
       Option::Function optVersion;
 
+      Option::CStr       optCacheDir;
+      Option::CStr       optClient;
+      Option::Bool       optDeps;
+      Option::CStr       optDepsFile;
+      Option::Bool       optDepsPhony;
       Option::CStr       optLibPath;
+      Option::Bool       optProgress;
+      Option::CStr       optServer;
       SystemSourceOption optSysSource;
+
+      // Command line, as passed to ProcessOptions.
+      char const *const *argV;
+      std::size_t        argC;
    };
 }
 
@@ -81,6 +93,13 @@ namespace GDCC::Core
 
    OptionList &GetOptions();
 
+   // Writes a dependency file for target, if requested by options.
+   void PutOptionDepends(FileDepends const &deps, char const *target);
+
+   // Sets the output from the last loose argument if not given, and exits
+   // with an error if there is none.
+   void ProcessOptionOutput(OptionList &opts);
+
    void ProcessOptions(OptionList &opts, int argc, char const *const *argv,
       bool needOutput = true);
 }
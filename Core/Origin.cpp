@@ -12,6 +12,66 @@
 
 #include "Core/Origin.hpp"
 
+#include "Core/Exception.hpp"
+
+#include <algorithm>
+#include <vector>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // OriginLine
+   //
+   // A range of codes for columns of one source line. A line can have more
+   // than one range if it is encoded again after other lines.
+   //
+   class OriginLine
+   {
+   public:
+      std::uint_least32_t base;
+      std::uint_least32_t size;
+      String              file;
+      std::size_t         line;
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::Core
+{
+   // Ranges in order of base. Code 0 is reserved for no origin.
+   static std::vector<OriginLine> OriginLines{{0, 1, nullptr, 0}};
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // OriginLineAdd
+   //
+   static void OriginLineAdd(String file, std::size_t line, std::size_t size)
+   {
+      std::uint_least32_t base = OriginCode::GetUsed();
+
+      if(size > UINT32_MAX - base)
+         Error({file, line}, "out of source origin codes");
+
+      OriginLines.push_back({base, static_cast<std::uint_least32_t>(size), file, line});
+   }
+}
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -19,6 +79,67 @@
 
 namespace GDCC::Core
 {
+   //
+   // OriginCode::Decode
+   //
+   Origin OriginCode::Decode(std::uint_least32_t code)
+   {
+      if(!code) return {nullptr, 0, 0};
+
+      auto itr = std::upper_bound(OriginLines.begin(), OriginLines.end(), code,
+         [](std::uint_least32_t c, OriginLine const &l) {return c < l.base;});
+
+      return {(itr - 1)->file, (itr - 1)->line, code - (itr - 1)->base};
+   }
+
+   //
+   // OriginCode::Encode
+   //
+   std::uint_least32_t OriginCode::Encode(Origin const &pos)
+   {
+      if(!pos) return 0;
+
+      // Origins are almost always encoded in source order, so only the last
+      // range is reused. Anything else starts a new range.
+      auto *line = &OriginLines.back();
+
+      if(line->file != pos.file || line->line != pos.line)
+      {
+         OriginLineAdd(pos.file, pos.line, pos.col + 1);
+         line = &OriginLines.back();
+      }
+      else if(pos.col >= line->size)
+      {
+         if(pos.col >= UINT32_MAX - line->base)
+            Error(pos, "out of source origin codes");
+
+         line->size = static_cast<std::uint_least32_t>(pos.col + 1);
+      }
+
+      return line->base + static_cast<std::uint_least32_t>(pos.col);
+   }
+
+   //
+   // OriginCode::GetUsed
+   //
+   std::uint_least32_t OriginCode::GetUsed()
+   {
+      return OriginLines.back().base + OriginLines.back().size;
+   }
+
+   //
+   // OriginCode::Release
+   //
+   void OriginCode::Release(std::uint_least32_t used)
+   {
+      while(OriginLines.back().base >= used && OriginLines.size() > 1)
+         OriginLines.pop_back();
+
+      auto &back = OriginLines.back();
+      if(back.base + back.size > used)
+         back.size = used - back.base;
+   }
+
    //
    // operator std::ostream << Origin
    //
@@ -34,6 +155,14 @@ namespace GDCC::Core
 
       return out;
    }
+
+   //
+   // operator std::ostream << OriginCode
+   //
+   std::ostream &operator << (std::ostream &out, OriginCode const &in)
+   {
+      return out << static_cast<Origin>(in);
+   }
 }
 
 // EOF
@@ -15,6 +15,8 @@
 
 #include "../Core/String.hpp"
 
+#include <cstdint>
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
@@ -45,6 +47,52 @@ namespace GDCC::Core
       std::size_t col;
    };
 
+   //
+   // OriginCode
+   //
+   // Compact encoding of an Origin as an offset into a table of source lines,
+   // which is shared by everything processed in one run. Encoding is cheap
+   // when origins are produced in source order. Decoding searches the table,
+   // so it should only be done when the full origin is needed.
+   //
+   class OriginCode
+   {
+   public:
+      OriginCode() = default;
+      OriginCode(Origin const &pos) : code{Encode(pos)} {}
+      OriginCode(String file, std::size_t line, std::size_t col = 0) :
+         code{Encode({file, line, col})} {}
+
+      operator Origin () const {return Decode(code);}
+
+      explicit constexpr operator bool () const {return code;}
+
+      bool operator == (OriginCode const &pos) const
+         {return code == pos.code || Decode(code) == Decode(pos.code);}
+
+      bool operator != (OriginCode const &pos) const {return !(*this == pos);}
+
+      std::size_t getCol() const {return Decode(code).col;}
+
+      String getFile() const {return Decode(code).file;}
+
+      std::size_t getLine() const {return Decode(code).line;}
+
+      std::uint_least32_t code = 0;
+
+
+      static Origin Decode(std::uint_least32_t code);
+
+      static std::uint_least32_t Encode(Origin const &pos);
+
+      // Returns the number of codes used so far.
+      static std::uint_least32_t GetUsed();
+
+      // Discards the codes used since GetUsed returned used. Codes from
+      // after that no longer decode to their origins.
+      static void Release(std::uint_least32_t used);
+   };
+
    //
    // OriginSource
    //
@@ -68,6 +116,7 @@ namespace GDCC::Core
 namespace GDCC::Core
 {
    std::ostream &operator << (std::ostream &out, Origin const &in);
+   std::ostream &operator << (std::ostream &out, OriginCode const &in);
 }
 
 #endif//GDCC__Core__Origin_H__
@@ -0,0 +1,290 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Single-pass source reading streambuf.
+//
+//-----------------------------------------------------------------------------
+
+#include "Core/SourceBuf.hpp"
+
+#if defined(__GNUC__) && defined(__SSE2__)
+# include <emmintrin.h>
+# define GDCC_Core_SourceBuf_SSE2 1
+#endif
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // CheckC
+   //
+   // Scans for characters that C mode cannot handle: carriage returns,
+   // non-ASCII characters, and adjacent question marks.
+   //
+   static bool CheckC(char const *itr, char const *end)
+   {
+      bool query = false;
+
+      #if GDCC_Core_SourceBuf_SSE2
+      auto const vecCR = _mm_set1_epi8('\r');
+      auto const vecQM = _mm_set1_epi8('?');
+
+      for(; end - itr >= 16; itr += 16)
+      {
+         auto vec = _mm_loadu_si128(reinterpret_cast<__m128i const *>(itr));
+
+         // The high bit of each byte is set for non-ASCII characters.
+         if(_mm_movemask_epi8(_mm_or_si128(vec, _mm_cmpeq_epi8(vec, vecCR))))
+            return false;
+
+         unsigned qm = _mm_movemask_epi8(_mm_cmpeq_epi8(vec, vecQM));
+         if((qm & (qm >> 1)) || (query && (qm & 1)))
+            return false;
+
+         query = qm & 0x8000;
+      }
+      #endif
+
+      for(; itr != end; ++itr)
+      {
+         if((*itr & 0x80) || *itr == '\r')
+            return false;
+
+         if(*itr == '?')
+         {
+            if(query) return false;
+            query = true;
+         }
+         else
+            query = false;
+      }
+
+      return true;
+   }
+
+   //
+   // CountOrigin
+   //
+   // Advances pos over the characters in the range, as OriginBuf would.
+   //
+   static void CountOrigin(char const *itr, char const *end, Origin &pos)
+   {
+      #if GDCC_Core_SourceBuf_SSE2
+      auto const vecNL = _mm_set1_epi8('\n');
+      auto const vecHi = _mm_set1_epi8(static_cast<char>(0xC0));
+      auto const vecCo = _mm_set1_epi8(static_cast<char>(0x80));
+
+      for(; end - itr >= 16; itr += 16)
+      {
+         auto vec = _mm_loadu_si128(reinterpret_cast<__m128i const *>(itr));
+
+         unsigned nl = _mm_movemask_epi8(_mm_cmpeq_epi8(vec, vecNL));
+         unsigned co = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(vec, vecHi), vecCo));
+
+         // Columns are counted for characters that are not UTF-8 continuation
+         // bytes and are after the last newline.
+         unsigned cols = ~co & 0xFFFF;
+
+         if(nl)
+         {
+            pos.line += __builtin_popcount(nl);
+            pos.col   = 1;
+
+            cols &= ~0u << (32 - __builtin_clz(nl));
+         }
+
+         pos.col += __builtin_popcount(cols);
+      }
+      #endif
+
+      for(; itr != end; ++itr)
+      {
+         if(*itr == '\n')
+            ++pos.line, pos.col = 1;
+         else if((*itr & 0xC0) != 0x80)
+            ++pos.col;
+      }
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::Core
+{
+   //
+   // SourceBuf constructor
+   //
+   SourceBuf::SourceBuf(char const *data, std::size_t size, Origin pos, Mode mode_) :
+      srcEnd{data + size},
+      srcItr{data},
+      srcMax{data},
+      cntItr{data},
+      cntPos{pos},
+      cntEOF{0},
+      mode  {mode_},
+      held  {false}
+   {
+      setg(buf, buf, buf);
+   }
+
+   //
+   // SourceBuf::Check
+   //
+   bool SourceBuf::Check(char const *data, std::size_t size, Origin pos, Mode mode)
+   {
+      // OriginBuf does not count lines and columns starting from zero.
+      if(!pos.line || !pos.col)
+         return false;
+
+      switch(mode)
+      {
+      case Mode::Raw: return true;
+      case Mode::C:   return CheckC(data, data + size);
+      }
+
+      return false;
+   }
+
+   //
+   // SourceBuf::nextC
+   //
+   // Implements the CPP::IStream chain. The positions requested are the
+   // characters that OriginBuf would be asked for by the following buffers,
+   // including the look-ahead of TrigraphBuf and StripEscapeBuf.
+   //
+   SourceBuf::int_type SourceBuf::nextC()
+   {
+      for(;;)
+      {
+         // Read the next character, unless it was already peeked.
+         if(!held)
+         {
+            request(srcItr);
+
+            if(srcItr == srcEnd)
+               return traits_type::eof();
+
+            if(*srcItr == '?')
+               request(srcItr + 1);
+         }
+
+         held = false;
+
+         char c = *srcItr++;
+         if(c != '\\')
+            return traits_type::to_int_type(c);
+
+         // Peek the next character for a line splice.
+         request(srcItr);
+
+         // If EOF is hit, pretend there was an EOL instead.
+         if(srcItr == srcEnd)
+            return request(srcItr), '\n';
+
+         if(*srcItr == '?')
+            request(srcItr + 1);
+
+         if(*srcItr != '\n')
+            return held = true, traits_type::to_int_type(c);
+
+         ++srcItr;
+      }
+   }
+
+   //
+   // SourceBuf::nextRaw
+   //
+   SourceBuf::int_type SourceBuf::nextRaw()
+   {
+      request(srcItr);
+
+      if(srcItr == srcEnd)
+         return traits_type::eof();
+
+      return traits_type::to_int_type(*srcItr++);
+   }
+
+   //
+   // SourceBuf::pbackfail
+   //
+   SourceBuf::int_type SourceBuf::pbackfail(int_type c)
+   {
+      if(gptr() == eback())
+         return traits_type::eof();
+
+      setg(eback(), gptr() - 1, egptr());
+      *gptr() = static_cast<char>(c);
+
+      return c;
+   }
+
+   //
+   // SourceBuf::request
+   //
+   void SourceBuf::request(char const *pos)
+   {
+      // OriginBuf advances the column for every read at EOF.
+      if(pos == srcEnd)
+         ++cntEOF;
+      else if(pos >= srcMax)
+         srcMax = pos + 1;
+   }
+
+   //
+   // SourceBuf::underflow
+   //
+   // Buffers like IBufferBuf<8, 2, 1>, so that the following characters are
+   // only requested when needed.
+   //
+   SourceBuf::int_type SourceBuf::underflow()
+   {
+      char *itr;
+
+      // If no buffer space left, shift to keep two characters for putback.
+      if(egptr() == buf + sizeof(buf))
+      {
+         itr = buf;
+         for(auto chr = gptr() - 2, end = itr + 2; itr != end;)
+            *itr++ = *chr++;
+         setg(buf, itr, itr);
+      }
+      else
+         itr = egptr();
+
+      auto c = mode == Mode::C ? nextC() : nextRaw();
+      if(c != traits_type::eof())
+         *itr++ = static_cast<char>(c);
+
+      setg(buf, gptr(), itr);
+
+      return gptr() == egptr() ? traits_type::eof() : *gptr();
+   }
+
+   //
+   // SourceBuf::v_getOrigin
+   //
+   Origin SourceBuf::v_getOrigin() const
+   {
+      CountOrigin(cntItr, srcMax, cntPos);
+      cntItr = srcMax;
+
+      Origin pos = cntPos;
+      pos.col += cntEOF;
+      return pos;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,84 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Single-pass source reading streambuf.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__Core__SourceBuf_H__
+#define GDCC__Core__SourceBuf_H__
+
+#include "../Core/Origin.hpp"
+
+#include <streambuf>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::Core
+{
+   //
+   // SourceBuf
+   //
+   // Reads a block of source text in place, producing the same characters
+   // and origins as the equivalent chain of filtering streambufs would. Raw
+   // mode is equivalent to OriginBuf alone. C mode is equivalent to the
+   // CPP::IStream chain, which also strips backslash-newline sequences.
+   //
+   // Origins are computed by counting lines and columns only when requested.
+   // Characters are produced one at a time, so that origins reflect the
+   // same read-ahead as the streambuf chain.
+   //
+   class SourceBuf final : public std::streambuf, public OriginSource
+   {
+   public:
+      enum class Mode
+      {
+         Raw,
+         C,
+      };
+
+
+      SourceBuf(char const *data, std::size_t size, Origin pos, Mode mode);
+
+      // Returns true if the source can be read by a SourceBuf. C mode does not
+      // handle carriage returns, trigraphs, or non-ASCII characters.
+      static bool Check(char const *data, std::size_t size, Origin pos, Mode mode);
+
+   protected:
+      virtual int_type pbackfail(int_type c);
+
+      virtual int_type underflow();
+
+      virtual Origin v_getOrigin() const;
+
+   private:
+      int_type nextC();
+      int_type nextRaw();
+
+      void request(char const *pos);
+
+      char const *const srcEnd;
+      char const       *srcItr;
+      char const       *srcMax;
+
+      mutable char const *cntItr;
+      mutable Origin      cntPos;
+      std::size_t         cntEOF;
+
+      Mode const mode;
+      bool       held;
+
+      char buf[8];
+   };
+}
+
+#endif//GDCC__Core__SourceBuf_H__
+
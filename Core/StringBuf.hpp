@@ -13,9 +13,11 @@
 #ifndef GDCC__Core__StringBuf_H__
 #define GDCC__Core__StringBuf_H__
 
+#include "../Core/File.hpp"
 #include "../Core/String.hpp"
 
 #include <istream>
+#include <memory>
 #include <streambuf>
 
 //----------------------------------------------------------------------------|
@@ -47,6 +49,59 @@ namespace GDCC::Core
          char *str = const_cast<char *>(str_);
          setg(str, str, str + len);
       }
+
+      //
+      // constructor
+      //
+      // Takes ownership of the file block.
+      //
+      explicit StringBuf(std::unique_ptr<FileBlock> &&block_) :
+         block{std::move(block_)}
+      {
+         char *str = const_cast<char *>(block->data());
+         setg(str, str, str + block->size());
+      }
+
+      // Returns the unread characters.
+      char const *data() const {return gptr();}
+      std::size_t size() const {return egptr() - gptr();}
+
+   protected:
+      //
+      // seekoff
+      //
+      virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+         std::ios_base::openmode which)
+      {
+         if(!(which & std::ios_base::in))
+            return pos_type(off_type(-1));
+
+         char *pos;
+         switch(dir)
+         {
+         case std::ios_base::beg: pos = eback() + off; break;
+         case std::ios_base::cur: pos = gptr()  + off; break;
+         case std::ios_base::end: pos = egptr() + off; break;
+         default: return pos_type(off_type(-1));
+         }
+
+         if(pos < eback() || pos > egptr())
+            return pos_type(off_type(-1));
+
+         setg(eback(), pos, egptr());
+         return pos_type(pos - eback());
+      }
+
+      //
+      // seekpos
+      //
+      virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which)
+      {
+         return seekoff(off_type(pos), std::ios_base::beg, which);
+      }
+
+   private:
+      std::unique_ptr<FileBlock> block;
    };
 
    //
@@ -143,14 +143,13 @@ namespace GDCC::Core
    {
    public:
       Token() = default;
-      constexpr Token(Origin pos_, String str_, TokenType tok_) :
+      constexpr Token(OriginCode pos_, String str_, TokenType tok_) :
          pos{pos_}, str{str_}, tok{tok_} {}
 
-      constexpr bool operator == (Token const &t) const
-         {return pos == t.pos && str == t.str && tok == t.tok;}
+      bool operator == (Token const &t) const
+         {return str == t.str && tok == t.tok && pos == t.pos;}
 
-      constexpr bool operator != (Token const &t) const
-         {return pos != t.pos || str != t.str || tok != t.tok;}
+      bool operator != (Token const &t) const {return !(*this == t);}
 
       //
       // isTokString
@@ -166,9 +165,9 @@ namespace GDCC::Core
       Token &setStrTok(String str_, TokenType tok_)
          {str = str_; tok = tok_; return *this;}
 
-      Origin    pos;
-      String    str;
-      TokenType tok;
+      OriginCode pos;
+      String     str;
+      TokenType  tok;
 
 
       // Returns the canonical token representation listed above.
@@ -183,7 +182,7 @@ namespace GDCC::Core
 
 namespace GDCC::Core
 {
-   constexpr Token TokenEOF{{STRNULL, 0, 0}, STRNULL, TOK_EOF};
+   constexpr Token TokenEOF{{}, STRNULL, TOK_EOF};
 }
 
 #endif//GDCC__Core__Token_H__
@@ -36,6 +36,8 @@ namespace GDCC::Core
 
       Token getToken() {return v_getToken();}
 
+      void skipGroup() {v_skipGroup();}
+
    protected:
       // Enables a specified token type. Returns true if token was enabled
       // before the call, false otherwise.
@@ -47,6 +49,10 @@ namespace GDCC::Core
 
       // Returns the next token.
       virtual Token v_getToken() = 0;
+
+      // Discards input up to the next line that may start with a directive.
+      // Only called at the start of a line in a skipped conditional group.
+      virtual void v_skipGroup() {}
    };
 
    //
@@ -0,0 +1,318 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Intermediary Representation compilation cache.
+//
+// Each cached source has a manifest, keyed by the command line and the
+// source's name and contents. The manifest lists the files read while
+// compiling along with their contents' hashes. If they all still match, the
+// IR is keyed by the manifest key and those hashes.
+//
+//-----------------------------------------------------------------------------
+
+#include "IR/Cache.hpp"
+
+#include "IR/IArchive.hpp"
+#include "IR/OArchive.hpp"
+#include "IR/Program.hpp"
+
+#include "Core/Dir.hpp"
+#include "Core/File.hpp"
+#include "Core/Option.hpp"
+#include "Core/Path.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::IR
+{
+   static std::size_t CacheHits   = 0;
+   static std::size_t CacheMisses = 0;
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   //
+   // CacheGetArgs
+   //
+   // Hash of the command line, less the inputs and options that do not
+   // affect compiled IR.
+   //
+   CacheHash const &CacheGetArgs()
+   {
+      static CacheHash const hash = []()
+      {
+         auto &opts = Core::GetOptions();
+
+         CacheHash h;
+         h.add(opts.list.version ? opts.list.version : "");
+         h.add(OArchive::Head, sizeof(OArchive::Head));
+
+         for(std::size_t i = 0; i != opts.argC; ++i)
+         {
+            auto arg = opts.argV[i];
+
+            if(arg == opts.optOutput.data() || arg == opts.optCacheDir.data() ||
+               arg == opts.optClient.data() || arg == opts.optServer.data() ||
+               arg == opts.optDepsFile.data() || !std::strcmp(arg, "--deps") ||
+               !std::strcmp(arg, "--deps-file") || !std::strcmp(arg, "--deps-phony") ||
+               !std::strcmp(arg, "-o") || !std::strcmp(arg, "--output") ||
+               !std::strcmp(arg, "--client") || !std::strcmp(arg, "--server") ||
+               !std::strcmp(arg, "--progress") ||
+               std::find(opts.args.begin(), opts.args.end(), arg) != opts.args.end())
+               continue;
+
+            h.add(arg);
+         }
+
+         return h;
+      }();
+
+      return hash;
+   }
+
+   //
+   // CacheGetPath
+   //
+   std::string CacheGetPath(CacheHash const &hash, char const *ext)
+   {
+      std::string path = Core::GetOptions().optCacheDir.data();
+      Core::PathAppend(path, (hash.str() + ext).data());
+      return path;
+   }
+
+   //
+   // CacheHash::add
+   //
+   CacheHash &CacheHash::add(char const *data, std::size_t size)
+   {
+      for(auto end = data + size; data != end; ++data)
+      {
+         lo ^= static_cast<unsigned char>(*data);
+
+         // Multiply by 2**88 + 0x13B.
+         std::uint_least64_t ll = (lo & 0xFFFFFFFF) * 0x13B;
+         std::uint_least64_t lh = (lo >> 32)        * 0x13B;
+
+         hi  = hi * 0x13B + (lh >> 32) + (((ll >> 32) + (lh & 0xFFFFFFFF)) >> 32) + (lo << 24);
+         lo  = ll + (lh << 32);
+         hi &= 0xFFFFFFFFFFFFFFFF;
+         lo &= 0xFFFFFFFFFFFFFFFF;
+      }
+
+      return *this;
+   }
+
+   //
+   // CacheHash::str
+   //
+   std::string CacheHash::str() const
+   {
+      char buf[33];
+      std::sprintf(buf, "%016llX%016llX",
+         static_cast<unsigned long long>(hi), static_cast<unsigned long long>(lo));
+      return {buf, 32};
+   }
+
+   //
+   // CacheHashFile
+   //
+   // Returns false if the file cannot be read.
+   //
+   bool CacheHashFile(char const *filename, CacheHash &hash)
+   {
+      std::ifstream in{filename, std::ios_base::in | std::ios_base::binary};
+      if(!in) return false;
+
+      char buf[4096];
+      while(in.read(buf, sizeof(buf)), in.gcount())
+         hash.add(buf, in.gcount());
+
+      return !in.bad();
+   }
+
+   //
+   // CacheParseFile
+   //
+   // Parses a source file, using and storing cached IR if enabled.
+   //
+   void CacheParseFile(char const *lang, char const *inName, Program &prog,
+      CacheParser parse)
+   {
+      auto dir = Core::GetOptions().optCacheDir.data();
+
+      // Standard input cannot be read twice.
+      if(!std::strcmp(inName, "-"))
+         return parse(inName, prog);
+
+      Core::FileDepends::Add(inName, std::strlen(inName));
+
+      if(!dir)
+         return parse(inName, prog);
+
+      CacheHash base = CacheGetArgs();
+      base.add(lang).add(inName);
+
+      // Let parse report unreadable sources.
+      if(!CacheHashFile(inName, base))
+         return parse(inName, prog);
+
+      auto manName = CacheGetPath(base, ".m");
+
+      // Look for IR compiled with the same included files. Files that were
+      // looked for but not found are listed with a hash of "-", and must
+      // still not be found.
+      if(std::ifstream man{manName})
+      {
+         CacheHash                key = base;
+         std::string              fileHash, file;
+         std::vector<std::string> files, absent;
+
+         bool match = true;
+         while(man >> fileHash && man.get() == ' ' && std::getline(man, file))
+         {
+            CacheHash cur;
+            bool      found = CacheHashFile(file.data(), cur);
+
+            if(fileHash == "-" ? found : !found || cur.str() != fileHash)
+               {match = false; break;}
+
+            key.add(file).add(fileHash);
+
+            if(fileHash == "-")
+               absent.push_back(std::move(file));
+            else
+               files.push_back(std::move(file));
+         }
+
+         if(match)
+         {
+            std::ifstream in{CacheGetPath(key, ".ir"),
+               std::ios_base::in | std::ios_base::binary};
+
+            if(in)
+            {
+               IArchive arc{in};
+               arc >> prog;
+
+               for(auto const &f : files)
+                  Core::FileDepends::Add(f.data(), f.size());
+
+               for(auto const &f : absent)
+                  Core::FileDepends::AddAbsent(f.data(), f.size());
+
+               ++CacheHits;
+               return;
+            }
+         }
+      }
+
+      ++CacheMisses;
+
+      // Compile into a separate program, so it can be stored alone.
+      Program     progNew;
+      std::string manData;
+      CacheHash   key   = base;
+      bool        store = true;
+
+      {
+         Core::FileDepends deps;
+         parse(inName, progNew);
+
+         for(auto const &file : deps.files)
+         {
+            CacheHash cur;
+            if(!CacheHashFile(file.data(), cur))
+               {store = false; break;}
+
+            auto fileHash = cur.str();
+            manData += fileHash + ' ' + file + '\n';
+            key.add(file).add(fileHash);
+         }
+
+         for(auto const &file : deps.absent)
+         {
+            manData += "- " + file + '\n';
+            key.add(file).add("-");
+         }
+
+         // Output that depends on more than the files, such as from
+         // __DATE__ or __TIME__, cannot be reused.
+         if(deps.special)
+            store = false;
+      }
+
+      std::ostringstream out;
+      OArchive arcOut{out};
+      arcOut.putHead();
+      arcOut << progNew;
+      arcOut.putTail();
+
+      auto irData = out.str();
+
+      // The IR is written first, so a manifest never names missing IR.
+      if(store)
+      {
+         Core::DirCreate(dir);
+         CachePutFile(CacheGetPath(key, ".ir"), irData);
+         CachePutFile(manName, manData);
+      }
+
+      std::istringstream in{irData};
+      IArchive arcIn{in};
+      arcIn >> prog;
+   }
+
+   //
+   // CachePutFile
+   //
+   // Writes to a temporary file first, so that other processes sharing the
+   // cache never see a partial file.
+   //
+   void CachePutFile(std::string const &path, std::string const &data)
+   {
+      auto tmp = path + '.' + std::to_string(std::random_device{}()) + ".tmp";
+
+      {
+         std::ofstream out{tmp, std::ios_base::out | std::ios_base::binary};
+         if(!out.write(data.data(), data.size()))
+            return (void)std::remove(tmp.data());
+      }
+
+      if(std::rename(tmp.data(), path.data()))
+         std::remove(tmp.data());
+   }
+
+   //
+   // CachePutStats
+   //
+   void CachePutStats(std::ostream &out)
+   {
+      if(!Core::GetOptions().optCacheDir.data())
+         return;
+
+      out << "cache: " << CacheHits << " hits, " << CacheMisses << " misses\n";
+   }
+}
+
+// EOF
+
@@ -0,0 +1,78 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Intermediary Representation compilation cache.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__IR__Cache_H__
+#define GDCC__IR__Cache_H__
+
+#include "../IR/Types.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::IR
+{
+   //
+   // CacheHash
+   //
+   // 128-bit FNV-1a.
+   //
+   class CacheHash
+   {
+   public:
+      CacheHash &add(char const *data, std::size_t size);
+      CacheHash &add(char const *str) {return add(str, std::strlen(str) + 1);}
+      CacheHash &add(std::string const &str) {return add(str.data(), str.size() + 1);}
+
+      std::string str() const;
+
+      std::uint_least64_t hi = 0x6C62272E07BB0142;
+      std::uint_least64_t lo = 0x62B821756295C58D;
+   };
+
+   using CacheParser = void (*)(char const *inName, Program &prog);
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   // Hash of the command line, less the inputs and options that do not
+   // affect compiled output.
+   CacheHash const &CacheGetArgs();
+
+   // Returns the path of a file in the cache directory.
+   std::string CacheGetPath(CacheHash const &hash, char const *ext);
+
+   // Returns false if the file cannot be read.
+   bool CacheHashFile(char const *filename, CacheHash &hash);
+
+   void CacheParseFile(char const *lang, char const *inName, Program &prog,
+      CacheParser parse);
+
+   // Atomically replaces a file in the cache directory.
+   void CachePutFile(std::string const &path, std::string const &data);
+
+   void CachePutStats(std::ostream &out);
+}
+
+#endif//GDCC__IR__Cache_H__
+
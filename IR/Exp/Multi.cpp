@@ -43,6 +43,23 @@ namespace GDCC::IR
    //
    Value Exp_Array::v_getValue() const
    {
+      if(Value_Array::IsPackable(elemT))
+      {
+         Core::Array<Core::FastU> packed(elemV.size());
+         auto                     itr = packed.begin();
+
+         for(auto const &elem : elemV)
+         {
+            auto value = elem->getValue();
+            if(value.v != ValueBase::Fixed || !(value.vFixed.vtype == elemT.tFixed))
+               goto unpacked;
+            *itr++ = Value_Array::Pack(value.vFixed);
+         }
+
+         return Value_Array(std::move(packed), {elemT, elemV.size()});
+      }
+
+   unpacked:
       std::vector<Value> values; values.reserve(elemV.size());
 
       for(auto const &elem : elemV)
@@ -15,7 +15,7 @@
 
 #include "../IR/Block.hpp"
 
-#include <unordered_map>
+#include <map>
 
 
 //----------------------------------------------------------------------------|
@@ -30,7 +30,7 @@ namespace GDCC::IR
    class Function
    {
    protected:
-      using LocalArr   = std::unordered_map<Core::FastU, Core::FastU>;
+      using LocalArr   = std::map<Core::FastU, Core::FastU>;
       using ScriptType = Core::Array<Core::String>;
 
    public:
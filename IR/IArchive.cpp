@@ -12,6 +12,8 @@
 
 #include "IR/IArchive.hpp"
 
+#include "IR/OArchive.hpp"
+
 #include "Core/Exception.hpp"
 
 #include "Target/Addr.hpp"
@@ -34,14 +36,19 @@ namespace GDCC::IR
       in{in_}
    {
       // Check header.
-      if(char buf[16]; !in.read(buf, 16) || std::memcmp(buf, "GDCC::IR\0\0\0\0\0\0\0", 16))
+      char buf[sizeof(OArchive::Head)];
+      if(!in.read(buf, sizeof(buf)) || std::memcmp(buf, OArchive::Head, 8))
          Core::Error({}, "not IR");
+      if(std::memcmp(buf, OArchive::Head, sizeof(buf)))
+         Core::Error({}, "IR from a different version");
 
       // Read start of table index.
       in.seekg(-1, std::ios_base::end);
       std::size_t idxLen = in.get();
       in.seekg(-static_cast<std::istream::off_type>(idxLen), std::ios_base::cur);
 
+      std::size_t idxEnd = static_cast<std::size_t>(in.tellg()) - 1;
+
       std::size_t idx = 0;
       for(auto i = idxLen; --i;)
          idx = (idx << 8) + in.get();
@@ -52,6 +59,10 @@ namespace GDCC::IR
 
       getStrTab();
 
+      // Program entry index follows the string table, if present.
+      if(static_cast<std::size_t>(in.tellg()) < idxEnd)
+         *this >> progIdx;
+
       in.seekg(16);
    }
 
@@ -20,6 +20,7 @@
 #include "../Core/StringBuf.hpp"
 
 #include <istream>
+#include <map>
 #include <sstream>
 #include <unordered_map>
 #include <vector>
@@ -68,8 +69,15 @@ namespace GDCC::IR
 
       bool getBool();
 
+      void seekg(std::size_t pos) {in.seekg(pos);}
+
+      std::size_t tellg() {return in.tellg();}
+
       Program *prog;
 
+      // Offsets of Program entries, if any were written.
+      std::vector<std::size_t> progIdx;
+
    private:
       template<typename T>
       T getI()
@@ -181,6 +189,20 @@ namespace GDCC::IR
       return in >> out.first >> out.second;
    }
 
+   //
+   // operator IArchive >> std::map
+   //
+   template<typename Key, typename T, typename Compare, typename Allocator>
+   IArchive &operator >> (IArchive &in, std::map<Key, T, Compare, Allocator> &out)
+   {
+      typename std::map<Key, T, Compare, Allocator>::size_type s;
+      in >> s;
+      out.clear();
+      while(s--)
+         out.emplace_hint(out.end(), GetIR_T<std::pair<Key, T>>::GetIR_F(in));
+      return in;
+   }
+
    //
    // operator IArchive >> std::unordered_map
    //
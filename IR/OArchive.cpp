@@ -28,7 +28,8 @@ namespace GDCC::IR
    // OArchive constructor
    //
    OArchive::OArchive(std::ostream &out_) :
-      strUse{Core::Size, Core::String::GetDataC(), false},
+      strIdx{{Core::STRNULL, 0}},
+      strTab{Core::STRNULL},
       out{out_}
    {
    }
@@ -38,10 +39,7 @@ namespace GDCC::IR
    //
    OArchive &OArchive::operator << (Core::String in)
    {
-      auto idx = static_cast<std::size_t>(in);
-      strUse[idx] = true;
-      putU(idx);
-
+      putStr(static_cast<std::size_t>(in));
       return *this;
    }
 
@@ -50,10 +48,7 @@ namespace GDCC::IR
    //
    OArchive &OArchive::operator << (Core::StringIndex in)
    {
-      auto idx = static_cast<std::size_t>(in);
-      strUse[idx] = true;
-      putU(idx);
-
+      putStr(static_cast<std::size_t>(in));
       return *this;
    }
 
@@ -100,7 +95,7 @@ namespace GDCC::IR
    //
    void OArchive::putHead()
    {
-      out.write("GDCC::IR\0\0\0\0\0\0\0", 16);
+      out.write(Head, sizeof(Head));
    }
 
    //
@@ -133,25 +128,30 @@ namespace GDCC::IR
       putInteg(in.get_den());
    }
 
+   //
+   // OArchive::putStr
+   //
+   void OArchive::putStr(std::size_t idx)
+   {
+      auto itr = strIdx.emplace(idx, strTab.size());
+      if(itr.second)
+         strTab.push_back(idx);
+
+      putU(itr.first->second);
+   }
+
    //
    // OArchive::putStrTab
    //
    void OArchive::putStrTab()
    {
-      putU(strUse.size());
+      putU(strTab.size());
 
       auto str = Core::String::GetDataV();
-      for(auto &use : strUse)
+      for(auto idx : strTab)
       {
-         if(use)
-         {
-            putU(str->size());
-            out.write(str->data(), str->size());
-         }
-         else
-            out.put(0);
-
-         ++str;
+         putU(str[idx].size());
+         out.write(str[idx].data(), str[idx].size());
       }
    }
 
@@ -164,6 +164,9 @@ namespace GDCC::IR
 
       putStrTab();
 
+      if(!progIdx.empty())
+         *this << progIdx;
+
       // Write index to tail data.
       constexpr std::size_t idxLen = sizeof(idx) * CHAR_BIT / 8;
       static_assert(idxLen < 256, "pos_type too large");
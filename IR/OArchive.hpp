@@ -19,6 +19,7 @@
 #include "../Core/Number.hpp"
 #include "../Core/String.hpp"
 
+#include <map>
 #include <ostream>
 #include <unordered_map>
 #include <utility>
@@ -69,6 +70,16 @@ namespace GDCC::IR
       void putHead();
       void putTail();
 
+      std::size_t tellp() {return out.tellp();}
+
+      // Offsets of Program entries, written after the string table.
+      std::vector<std::size_t> progIdx;
+
+      // Start of every archive. The byte before the terminating null is the
+      // format version, which is changed with the format so that older
+      // archives are rejected.
+      static constexpr char Head[16] = "GDCC::IR\0\0\0\0\0\0\1";
+
    private:
       template<typename T>
       void putI(T in)
@@ -82,6 +93,8 @@ namespace GDCC::IR
 
       void putRatio(Core::Ratio const &in);
 
+      void putStr(std::size_t idx);
+
       void putStrTab();
 
       template<typename T>
@@ -97,7 +110,11 @@ namespace GDCC::IR
          out.write(ptr, (buf + len) - ptr);
       }
 
-      Core::Array<bool> strUse;
+      // Strings are numbered in order of first use, so that the table only
+      // has the strings used and does not depend on what else was interned.
+      // The null string is always first.
+      std::unordered_map<std::size_t, std::size_t> strIdx;
+      std::vector<std::size_t>                     strTab;
 
       std::ostream &out;
    };
@@ -123,6 +140,10 @@ namespace GDCC::IR
    template<typename T1, typename T2>
    OArchive &operator << (OArchive &out, std::pair<T1, T2> const &in);
 
+   template<typename Key, typename T, typename Compare, typename Allocator>
+   OArchive &operator << (OArchive &out,
+      std::map<Key, T, Compare, Allocator> const &in);
+
    template<typename Key, typename T, typename Hash, typename KeyEqual, typename Allocator>
    OArchive &operator << (OArchive &out,
       std::unordered_map<Key, T, Hash, KeyEqual, Allocator> const &in);
@@ -151,6 +172,19 @@ namespace GDCC::IR
       return out << in.first << in.second;
    }
 
+   //
+   // operator OArchive << std::map
+   //
+   template<typename Key, typename T, typename Compare, typename Allocator>
+   OArchive &operator << (OArchive &out,
+      std::map<Key, T, Compare, Allocator> const &in)
+   {
+      out << in.size();
+      for(auto const &i : in)
+         out << i;
+      return out;
+   }
+
    //
    // operator OArchive << std::unordered_map
    //
@@ -61,6 +61,60 @@ namespace GDCC::IR
       return itr == table.end() ? nullptr : &itr->second;
    }
 
+   //
+   // GetEntries
+   //
+   // Reads a table's entries. get reads the data following an entry's name,
+   // keeping it if requested.
+   //
+   template<typename Get>
+   static void GetEntries(IArchive &in, ProgramFilter *filter,
+      ProgramTable table, std::size_t &idx, Get const &get)
+   {
+      Core::String name;
+
+      // With an index, only decode the entries to keep.
+      if(filter && !in.progIdx.empty())
+      {
+         auto getIdx = [&]()
+         {
+            if(idx == in.progIdx.size())
+               Core::Error({}, "bad IR progIdx");
+
+            return in.progIdx[idx++];
+         };
+
+         for(auto count = getIdx(); count--;)
+         {
+            auto pos = getIdx();
+
+            in.seekg(pos);
+            in >> name;
+
+            if(!filter->filter(table, name))
+               continue;
+
+            get(name, true);
+            filter->filterSize(table, name, in.tellg() - pos);
+         }
+
+         return;
+      }
+
+      for(auto count = GetIR<std::size_t>(in); count--;)
+      {
+         auto pos = in.tellg();
+         in >> name;
+
+         bool keep = !filter || filter->filter(table, name);
+
+         get(name, keep);
+
+         if(keep && filter)
+            filter->filterSize(table, name, in.tellg() - pos);
+      }
+   }
+
    //
    // GetTable
    //
@@ -68,19 +122,34 @@ namespace GDCC::IR
    static T &GetTable(Program::Table<T> &table, Core::String glyph,
       Args &&...args)
    {
-      auto itr = table.find(glyph);
+      auto itr = table.lower_bound(glyph);
 
-      if(itr == table.end())
+      if(itr == table.end() || table.key_comp()(glyph, itr->first))
       {
-         itr = table.emplace(std::piecewise_construct,
+         itr = table.emplace_hint(itr, std::piecewise_construct,
             std::forward_as_tuple(glyph),
-            std::forward_as_tuple(std::forward<Args>(args)...)
-            ).first;
+            std::forward_as_tuple(std::forward<Args>(args)...));
       }
 
       return itr->second;
    }
 
+   //
+   // PutEntries
+   //
+   template<typename T>
+   static void PutEntries(OArchive &out, Program::Table<T> const &table)
+   {
+      out << table.size();
+      out.progIdx.push_back(table.size());
+
+      for(auto const &itr : table)
+      {
+         out.progIdx.push_back(out.tellp());
+         out << itr;
+      }
+   }
+
    //
    // RangeTable
    //
@@ -775,18 +844,16 @@ namespace GDCC::IR
    //
    OArchive &operator << (OArchive &out, Program const &in)
    {
-      out
-         << in.tableDJump
-         << in.tableFunction
-         << in.tableGlyphData
-         << in.tableImport
-         << in.tableSpaceGblArs
-         << in.tableSpaceHubArs
-         << in.tableSpaceLocArs
-         << in.tableSpaceModArs
-         << in.tableStrEnt
-         << in.tableObject
-      ;
+      PutEntries(out, in.tableDJump);
+      PutEntries(out, in.tableFunction);
+      PutEntries(out, in.tableGlyphData);
+      PutEntries(out, in.tableImport);
+      PutEntries(out, in.tableSpaceGblArs);
+      PutEntries(out, in.tableSpaceHubArs);
+      PutEntries(out, in.tableSpaceLocArs);
+      PutEntries(out, in.tableSpaceModArs);
+      PutEntries(out, in.tableStrEnt);
+      PutEntries(out, in.tableObject);
 
       return out;
    }
@@ -796,78 +863,88 @@ namespace GDCC::IR
    //
    IArchive &operator >> (IArchive &in, Program &out)
    {
+      return GetProgram(in, out, nullptr);
+   }
+
+   //
+   // GetProgram
+   //
+   IArchive &GetProgram(IArchive &in, Program &out, ProgramFilter *filter)
+   {
+      std::size_t idx = 0;
+
       in.prog = &out;
 
       // tableDJump
-      for(auto count = GetIR<Program::Table<DJump>::size_type>(in); count--;)
+      GetEntries(in, filter, ProgramTable::DJump, idx,
+         [&](Core::String name, bool keep)
       {
-         Core::String name;          in >> name;
-         DJump        newJump{name}; in >> newJump;
+         DJump newJump{name}; in >> newJump;
 
-         out.mergeDJump(out.getDJump(name), std::move(newJump));
-      }
+         if(keep) out.mergeDJump(out.getDJump(name), std::move(newJump));
+      });
 
       // tableFunction
-      for(auto count = GetIR<Program::Table<Function>::size_type>(in); count--;)
+      GetEntries(in, filter, ProgramTable::Function, idx,
+         [&](Core::String name, bool keep)
       {
-         Core::String name;          in >> name;
-         Function     newFunc{name}; in >> newFunc;
+         Function newFunc{name}; in >> newFunc;
 
-         out.mergeFunction(out.getFunction(name), std::move(newFunc));
-      }
+         if(keep) out.mergeFunction(out.getFunction(name), std::move(newFunc));
+      });
 
       // tableGlyphData
-      for(auto count = GetIR<Program::Table<GlyphData>::size_type>(in); count--;)
+      GetEntries(in, filter, ProgramTable::GlyphData, idx,
+         [&](Core::String name, bool keep)
       {
-         Core::String name;          in >> name;
-         GlyphData    newData{name}; in >> newData;
+         GlyphData newData{name}; in >> newData;
 
-         out.mergeGlyphData(out.getGlyphData(name), std::move(newData));
-      }
+         if(keep) out.mergeGlyphData(out.getGlyphData(name), std::move(newData));
+      });
 
       // tableImport
-      for(auto count = GetIR<Program::Table<Import>::size_type>(in); count--;)
+      GetEntries(in, filter, ProgramTable::Import, idx,
+         [&](Core::String name, bool keep)
       {
-         Core::String name;         in >> name;
-         Import       newImp{name}; in >> newImp;
+         Import newImp{name}; in >> newImp;
 
-         out.mergeImport(out.getImport(name), std::move(newImp));
-      }
+         if(keep) out.mergeImport(out.getImport(name), std::move(newImp));
+      });
 
       // tableSpace*
-      auto getSpace = [&](AddrBase base, Space &(Program::*getter)(Core::String))
+      auto getSpace = [&](ProgramTable table, AddrBase base,
+         Space &(Program::*getter)(Core::String))
       {
-         for(auto count = GetIR<Program::Table<Space>::size_type>(in); count--;)
+         GetEntries(in, filter, table, idx, [&](Core::String name, bool keep)
          {
-            Core::String name;                            in >> name;
-            Space        newSpace{AddrSpace(base, name)}; in >> newSpace;
+            Space newSpace{AddrSpace(base, name)}; in >> newSpace;
 
-            out.mergeSpace((out.*getter)(name), std::move(newSpace));
-         }
+            if(keep) out.mergeSpace((out.*getter)(name), std::move(newSpace));
+         });
       };
 
-      getSpace(AddrBase::GblArr, &Program::getSpaceGblArr);
-      getSpace(AddrBase::HubArr, &Program::getSpaceHubArr);
-      getSpace(AddrBase::LocArr, &Program::getSpaceLocArr);
-      getSpace(AddrBase::ModArr, &Program::getSpaceModArr);
+      getSpace(ProgramTable::SpaceGblArs, AddrBase::GblArr, &Program::getSpaceGblArr);
+      getSpace(ProgramTable::SpaceHubArs, AddrBase::HubArr, &Program::getSpaceHubArr);
+      getSpace(ProgramTable::SpaceLocArs, AddrBase::LocArr, &Program::getSpaceLocArr);
+      getSpace(ProgramTable::SpaceModArs, AddrBase::ModArr, &Program::getSpaceModArr);
 
       // tableStrEnt
-      for(auto count = GetIR<Program::Table<StrEnt>::size_type>(in); count--;)
+      GetEntries(in, filter, ProgramTable::StrEnt, idx,
+         [&](Core::String name, bool keep)
       {
-         Core::String name;         in >> name;
-         StrEnt       newStr{name}; in >> newStr;
+         StrEnt newStr{name}; in >> newStr;
 
-         out.mergeStrEnt(out.getStrEnt(name), std::move(newStr));
-      }
+         if(keep) out.mergeStrEnt(out.getStrEnt(name), std::move(newStr));
+      });
 
       // tableObject
-      for(auto count = GetIR<Program::Table<Object>::size_type>(in); count--;)
+      GetEntries(in, filter, ProgramTable::Object, idx,
+         [&](Core::String name, bool keep)
       {
-         Core::String name;         in >> name;
-         Object       newObj{name}; in >> newObj;
+         Object newObj{name}; in >> newObj;
 
-         out.mergeObject(out.getObject(name), std::move(newObj));
-      }
+         if(keep) out.mergeObject(out.getObject(name), std::move(newObj));
+      });
 
       in.prog = nullptr;
 
@@ -24,6 +24,7 @@
 #include "../Core/MemItr.hpp"
 #include "../Core/Range.hpp"
 
+#include <map>
 #include <unordered_map>
 
 
@@ -33,6 +34,40 @@
 
 namespace GDCC::IR
 {
+   //
+   // ProgramTable
+   //
+   enum class ProgramTable
+   {
+      DJump,
+      Function,
+      GlyphData,
+      Import,
+      SpaceGblArs,
+      SpaceHubArs,
+      SpaceLocArs,
+      SpaceModArs,
+      StrEnt,
+      Object,
+   };
+
+   //
+   // ProgramFilter
+   //
+   // Selects the entries to keep when reading a Program.
+   //
+   class ProgramFilter
+   {
+   public:
+      virtual ~ProgramFilter() {}
+
+      // Returns true if the named entry should be kept.
+      virtual bool filter(ProgramTable table, Core::String name) = 0;
+
+      // Called with the encoded size of each kept entry.
+      virtual void filterSize(ProgramTable, Core::String, std::size_t) {}
+   };
+
    //
    // Program
    //
@@ -40,7 +75,7 @@ namespace GDCC::IR
    {
    public:
       template<typename T>
-      using Table = std::unordered_map<Core::String, T>;
+      using Table = std::map<Core::String, T>;
 
       template<typename T>
       using TableRange = Core::Range<Core::MemItr<typename Table<T>::iterator>>;
@@ -157,5 +192,17 @@ namespace GDCC::IR
    };
 }
 
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   // Reads a Program, keeping only the entries accepted by filter. If the
+   // archive has an entry index, other entries are not decoded at all.
+   IArchive &GetProgram(IArchive &in, Program &out, ProgramFilter *filter);
+}
+
 #endif//GDCC__IR__Program_H__
 
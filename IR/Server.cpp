@@ -0,0 +1,386 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Compile server.
+//
+// The server is started with the options to compile with and then takes
+// requests on a local socket one at a time, so that everything read and
+// interned by one compile, such as strings, headers, and imports, is kept
+// for the next. Each compile builds its own macros, scopes, and program, as
+// when compiling several sources in one run.
+//
+// Source origins are never freed during a run, and the caches keep origins
+// of their own. So once the compiles have used ServerOriginMax origin codes,
+// the caches are cleared and the origins released. Interned strings are kept
+// for the life of the server, but output only lists the strings it uses, so
+// it is the same as from compiling directly.
+//
+// A request is a list of null-terminated strings: the program name and
+// version, the working directory, the output, the number of options and the
+// options themselves, and then the inputs. The client then closes its end
+// for writing. The response is the exit status on its own line, followed by
+// the compile's diagnostics.
+//
+//-----------------------------------------------------------------------------
+
+#include "IR/Server.hpp"
+
+#include "Core/Exception.hpp"
+#include "Core/Option.hpp"
+#include "Core/Origin.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+# include <csignal>
+# include <sys/socket.h>
+# include <sys/stat.h>
+# include <sys/un.h>
+# include <unistd.h>
+#endif
+
+
+//----------------------------------------------------------------------------|
+// Static Objects                                                             |
+//
+
+namespace GDCC::IR
+{
+   // Origin codes used by compiles before the caches are cleared. Roughly one
+   // per byte of source read, and much less than the 32-bit code space.
+   static constexpr std::uint_least32_t ServerOriginMax = 0x4000000;
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+#ifndef _WIN32
+namespace GDCC::IR
+{
+   //
+   // ServerAddr
+   //
+   static sockaddr_un ServerAddr(char const *path)
+   {
+      sockaddr_un addr{};
+      addr.sun_family = AF_UNIX;
+
+      if(std::strlen(path) >= sizeof(addr.sun_path))
+         Core::Error({}, "socket path too long: '" + std::string{path} + '\'');
+
+      std::strcpy(addr.sun_path, path);
+      return addr;
+   }
+
+   //
+   // ServerExec
+   //
+   // Runs one request, writing diagnostics to diag. Returns the exit status.
+   //
+   static int ServerExec(std::vector<std::string> const &req,
+      std::vector<std::string> const &args, ServerCompile compile,
+      std::ostream &diag)
+   {
+      auto &opts = Core::GetOptions();
+      auto  err  = std::cerr.rdbuf(diag.rdbuf());
+      int   res  = EXIT_SUCCESS;
+
+      try
+      {
+         if(req.size() < 5 || req[0] != opts.list.name || req[1] != opts.list.version)
+            Core::Error({}, "invalid request");
+
+         std::size_t argc = std::strtoul(req[4].data(), nullptr, 10);
+         if(req.size() - 5 < argc || !std::equal(args.begin(), args.end(),
+            req.begin() + 5, req.begin() + 5 + argc))
+            Core::Error({}, "options differ from server's");
+
+         if(chdir(req[2].data()))
+            Core::Error({}, "cannot change directory: '" + req[2] + '\'');
+
+         // Replace the inputs and output.
+         std::vector<char const *> inputs;
+         for(auto i = req.begin() + 5 + argc, e = req.end(); i != e; ++i)
+            inputs.push_back(i->data());
+
+         while(opts.args.size())
+            opts.args.pop();
+
+         opts.args.process(Option::Args().setArgs(inputs.data(), inputs.size()));
+         opts.optOutput.reset(req[3].data(), true);
+
+         compile();
+      }
+      catch(std::exception const &e)
+      {
+         std::cerr << "ERROR: " << e.what() << std::endl;
+         res = EXIT_FAILURE;
+      }
+      catch(int e)
+      {
+         res = e;
+      }
+
+      std::cerr.rdbuf(err);
+      return res;
+   }
+
+   //
+   // ServerGetArgs
+   //
+   // Returns the command line, less the inputs, output, and server options.
+   // The client and server must have the same.
+   //
+   static std::vector<std::string> ServerGetArgs()
+   {
+      auto &opts = Core::GetOptions();
+
+      std::vector<std::string> args;
+
+      for(std::size_t i = 0; i != opts.argC; ++i)
+      {
+         auto arg = opts.argV[i];
+
+         if(arg == opts.optOutput.data() || arg == opts.optClient.data() ||
+            arg == opts.optServer.data() || !std::strcmp(arg, "-o") ||
+            !std::strcmp(arg, "--output") || !std::strcmp(arg, "--client") ||
+            !std::strcmp(arg, "--server") ||
+            std::find(opts.args.begin(), opts.args.end(), arg) != opts.args.end())
+            continue;
+
+         args.emplace_back(arg);
+      }
+
+      return args;
+   }
+
+   //
+   // ServerPut
+   //
+   static void ServerPut(std::string &out, std::string const &str)
+   {
+      out += str;
+      out += '\0';
+   }
+
+   //
+   // ServerRead
+   //
+   // Reads until end of stream.
+   //
+   static bool ServerRead(int fd, std::string &out)
+   {
+      char buf[4096];
+
+      for(;;)
+      {
+         auto n = read(fd, buf, sizeof(buf));
+
+         if(n > 0)
+            out.append(buf, n);
+         else if(n == 0)
+            return true;
+         else if(errno != EINTR)
+            return false;
+      }
+   }
+
+   //
+   // ServerSplit
+   //
+   static std::vector<std::string> ServerSplit(std::string const &in)
+   {
+      std::vector<std::string> out;
+
+      for(std::size_t pos = 0, end; (end = in.find('\0', pos)) != std::string::npos; pos = end + 1)
+         out.emplace_back(in, pos, end - pos);
+
+      return out;
+   }
+
+   //
+   // ServerWrite
+   //
+   static bool ServerWrite(int fd, std::string const &in)
+   {
+      for(char const *itr = in.data(), *end = itr + in.size(); itr != end;)
+      {
+         auto n = write(fd, itr, end - itr);
+
+         if(n >= 0)
+            itr += n;
+         else if(errno != EINTR)
+            return false;
+      }
+
+      return true;
+   }
+}
+#endif
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   //
+   // ServerClient
+   //
+   int ServerClient()
+   {
+      #ifdef _WIN32
+      Core::Error({}, "--client is not supported on this platform");
+      #else
+      auto &opts = Core::GetOptions();
+
+      // Standard input and output cannot be passed on.
+      for(auto const &arg : opts.args)
+         if(!std::strcmp(arg, "-"))
+            Core::Error({}, "--client cannot read standard input");
+
+      if(!std::strcmp(opts.optOutput.data(), "-"))
+         Core::Error({}, "--client cannot write standard output");
+
+      std::string cwd(256, '\0');
+      while(!getcwd(&cwd[0], cwd.size()))
+      {
+         if(errno != ERANGE)
+            Core::Error({}, "cannot get working directory");
+
+         cwd.resize(cwd.size() * 2);
+      }
+      cwd.resize(std::strlen(cwd.data()));
+
+      // Build request.
+      auto        args = ServerGetArgs();
+      std::string req;
+
+      ServerPut(req, opts.list.name);
+      ServerPut(req, opts.list.version);
+      ServerPut(req, cwd);
+      ServerPut(req, opts.optOutput.data());
+      ServerPut(req, std::to_string(args.size()));
+
+      for(auto const &arg : args)
+         ServerPut(req, arg);
+
+      for(auto const &arg : opts.args)
+         ServerPut(req, arg);
+
+      // Send request and wait for response.
+      auto        addr = ServerAddr(opts.optClient.data());
+      int         fd   = socket(AF_UNIX, SOCK_STREAM, 0);
+      std::string res;
+
+      if(fd < 0 || connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)))
+      {
+         if(fd >= 0) close(fd);
+         Core::Error({}, "cannot connect to server: '" + std::string{addr.sun_path} + '\'');
+      }
+
+      bool ok = ServerWrite(fd, req) && !shutdown(fd, SHUT_WR) && ServerRead(fd, res);
+      close(fd);
+
+      auto eol = res.find('\n');
+      if(!ok || eol == std::string::npos)
+         Core::Error({}, "no response from server");
+
+      std::cerr.write(res.data() + eol + 1, res.size() - eol - 1);
+      return std::atoi(res.data());
+      #endif
+   }
+
+   //
+   // ServerRun
+   //
+   void ServerRun(ServerCompile compile, ServerClear clear)
+   {
+      #ifdef _WIN32
+      (void)compile;
+      (void)clear;
+      Core::Error({}, "--server is not supported on this platform");
+      #else
+      auto &opts = Core::GetOptions();
+
+      if(opts.args.size() || opts.optOutput.data())
+         Core::Error({}, "--server takes no inputs or output");
+
+      auto args = ServerGetArgs();
+      auto addr = ServerAddr(opts.optServer.data());
+      auto path = addr.sun_path;
+      auto sock = reinterpret_cast<sockaddr *>(&addr);
+
+      // Replace a socket left by a stopped server, but not a running one.
+      int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      if(fd >= 0 && !connect(fd, sock, sizeof(addr)))
+         Core::Error({}, "server already running: '" + std::string{path} + '\'');
+      if(fd >= 0)
+         close(fd);
+
+      struct stat st;
+      if(!lstat(path, &st) && S_ISSOCK(st.st_mode))
+         unlink(path);
+
+      // Only the user may connect.
+      auto mask = umask(0077);
+      int  lfd  = socket(AF_UNIX, SOCK_STREAM, 0);
+      bool ok   = lfd >= 0 && !bind(lfd, sock, sizeof(addr)) && !listen(lfd, SOMAXCONN);
+      umask(mask);
+
+      if(!ok)
+         Core::Error({}, "cannot listen on socket: '" + std::string{path} + '\'');
+
+      // A client that goes away must not stop the server.
+      std::signal(SIGPIPE, SIG_IGN);
+
+      // Origins from before the first compile, such as for -D, are kept.
+      auto originBase = Core::OriginCode::GetUsed();
+
+      for(;;)
+      {
+         if((fd = accept(lfd, nullptr, nullptr)) < 0)
+         {
+            if(errno == EINTR || errno == ECONNABORTED)
+               continue;
+
+            Core::Error({}, "cannot accept on socket: '" + std::string{path} + '\'');
+         }
+
+         std::string req;
+         if(ServerRead(fd, req))
+         {
+            std::ostringstream diag;
+            int res = ServerExec(ServerSplit(req), args, compile, diag);
+            ServerWrite(fd, std::to_string(res) + '\n' + diag.str());
+         }
+
+         close(fd);
+
+         if(Core::OriginCode::GetUsed() - originBase > ServerOriginMax)
+         {
+            clear();
+            Core::OriginCode::Release(originBase);
+         }
+      }
+      #endif
+   }
+}
+
+// EOF
+
@@ -0,0 +1,50 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Compile server.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__IR__Server_H__
+#define GDCC__IR__Server_H__
+
+#include "../IR/Types.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::IR
+{
+   // Discards everything kept between compiles.
+   using ServerClear = void (*)();
+
+   // Compiles the inputs and output currently set in the options.
+   using ServerCompile = void (*)();
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::IR
+{
+   // Sends the compile given by the options to the server named by --client,
+   // writing its diagnostics to stderr. Returns the compile's exit status.
+   int ServerClient();
+
+   // Runs the server named by --server, calling compile for each request.
+   // Calls clear when what is kept between compiles gets too large.
+   [[noreturn]]
+   void ServerRun(ServerCompile compile, ServerClear clear);
+}
+
+#endif//GDCC__IR__Server_H__
+
@@ -20,6 +20,8 @@
 #include "Target/Addr.hpp"
 #include "Target/Info.hpp"
 
+#include <limits>
+
 
 //----------------------------------------------------------------------------|
 // Extern Objects                                                             |
@@ -41,8 +43,53 @@ namespace GDCC::IR
    //
    // Value_Array constructor
    //
-   Value_Array::Value_Array(IArchive &in) : vtype{in}, value{GetIR(in, value)}
+   Value_Array::Value_Array(IArchive &in) : vtype{in}, value{GetIR(in, value)},
+      packed{GetIR(in, packed)}
+   {
+   }
+
+   //
+   // Value_Array::getElem
+   //
+   Value Value_Array::getElem(std::size_t index) const
+   {
+      if(packed.empty())
+         return value[index];
+
+      return Unpack(packed[index], vtype.elemT->tFixed);
+   }
+
+   //
+   // Value_Array::IsPackable
+   //
+   // Fixed elements that fit in a FastU can be packed.
+   //
+   bool Value_Array::IsPackable(Type const &elemT)
    {
+      return elemT.t == TypeBase::Fixed &&
+         elemT.tFixed.getBits() <= std::numeric_limits<Core::FastU>::digits;
+   }
+
+   //
+   // Value_Array::Pack
+   //
+   Core::FastU Value_Array::Pack(Value_Fixed const &val)
+   {
+      if(val.vtype.bitsS)
+         return Core::NumberCast<Core::FastI>(val.value);
+      else
+         return Core::NumberCast<Core::FastU>(val.value);
+   }
+
+   //
+   // Value_Array::Unpack
+   //
+   Value_Fixed Value_Array::Unpack(Core::FastU val, Type_Fixed const &elemT)
+   {
+      if(elemT.bitsS)
+         return {Core::NumberCast<Core::Integ>(static_cast<Core::FastI>(val)), elemT};
+      else
+         return {Core::NumberCast<Core::Integ>(val), elemT};
    }
 
    //
@@ -278,7 +325,7 @@ namespace GDCC::IR
    //
    OArchive &operator << (OArchive &out, Value_Array const &in)
    {
-      return out << in.vtype << in.value;
+      return out << in.vtype << in.value << in.packed;
    }
 
    //
@@ -382,7 +429,7 @@ namespace GDCC::IR
    //
    IArchive &operator >> (IArchive &in, Value_Array &out)
    {
-      return in >> out.vtype >> out.value;
+      return in >> out.vtype >> out.value >> out.packed;
    }
 
    //
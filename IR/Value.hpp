@@ -39,12 +39,29 @@ namespace GDCC::IR
       Value_Array(Core::Array<Value> &&value_, Type_Array &&vtype_) :
          vtype{std::move(vtype_)}, value{std::move(value_)} {}
 
+      Value_Array(Core::Array<Core::FastU> &&packed_, Type_Array const &vtype_) :
+         vtype{vtype_}, packed{std::move(packed_)} {}
+
       explicit Value_Array(IArchive &in);
 
-      explicit operator bool () const {return !value.empty();}
+      explicit operator bool () const {return !value.empty() || !packed.empty();}
+
+      Value getElem(std::size_t index) const;
+
+      std::size_t size() const {return packed.empty() ? value.size() : packed.size();}
 
       Type_Array         vtype;
       Core::Array<Value> value;
+
+      // Elements of a packed array, if not in value.
+      Core::Array<Core::FastU> packed;
+
+
+      static bool IsPackable(Type const &elemT);
+
+      static Core::FastU Pack(Value_Fixed const &val);
+
+      static Value_Fixed Unpack(Core::FastU val, Type_Fixed const &elemT);
    };
 
    //
@@ -0,0 +1,177 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// IR entry selection.
+//
+//-----------------------------------------------------------------------------
+
+#include "IRDump/Filter.hpp"
+
+#include "IRDump/Put.hpp"
+
+#include "Core/Option.hpp"
+
+#include "Option/CStr.hpp"
+#include "Option/CStrV.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------|
+// Options                                                                    |
+//
+
+namespace GDCC::IRDump
+{
+   //
+   // --function
+   //
+   static Option::CStrV FilterFunction
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("function")
+         .setGroup("filter")
+         .setDescS("Dumps only the named function.")
+         .setDescL("Dumps only the named function, including its block. Can "
+            "be given more than once to dump several functions."),
+
+      1
+   };
+
+   //
+   // --glyph
+   //
+   static Option::CStr FilterGlyph
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("glyph")
+         .setGroup("filter")
+         .setDescS("Dumps only entries with glyphs matching a regex.")
+         .setDescL("Dumps only entries with glyphs matching an ECMAScript "
+            "regular expression. Address spaces are matched by name."),
+   };
+
+   //
+   // --object
+   //
+   static Option::CStrV FilterObject
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("object")
+         .setGroup("filter")
+         .setDescS("Dumps only the named object.")
+         .setDescL("Dumps only the named object. Can be given more than once "
+            "to dump several objects."),
+
+      1
+   };
+}
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::IRDump
+{
+   //
+   // FilterName
+   //
+   static bool FilterName(Option::CStrV const &names, Core::String name)
+   {
+      return !names.size() || std::any_of(names.begin(), names.end(),
+         [&](char const *n) {return !std::strcmp(n, name.data());});
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::IRDump
+{
+   //
+   // Filter constructor
+   //
+   Filter::Filter()
+   {
+      if(FilterFunction.size())
+      {
+         DumpBlock    = true;
+         DumpFunction = true;
+      }
+
+      if(FilterObject.size())
+         DumpObject = true;
+
+      if(FilterGlyph.data())
+         glyph.reset(new std::regex(FilterGlyph.data()));
+   }
+
+   //
+   // Filter::filter
+   //
+   bool Filter::filter(IR::ProgramTable table, Core::String name)
+   {
+      // Statistics count every entry that matches.
+      bool stats = DumpStatistics;
+
+      switch(table)
+      {
+      case IR::ProgramTable::DJump:
+         if(!DumpDJump && !stats) return false;
+         break;
+
+      case IR::ProgramTable::Function:
+         if(!DumpFunction && !DumpStats && !stats) return false;
+         if(!FilterName(FilterFunction, name)) return false;
+         break;
+
+      case IR::ProgramTable::GlyphData:
+         if(!DumpGlyph && !stats) return false;
+         break;
+
+      case IR::ProgramTable::Import:
+         if(!DumpImport && !stats) return false;
+         break;
+
+      case IR::ProgramTable::Object:
+         if(!DumpObject && !stats) return false;
+         if(!FilterName(FilterObject, name)) return false;
+         break;
+
+      case IR::ProgramTable::SpaceGblArs:
+      case IR::ProgramTable::SpaceHubArs:
+      case IR::ProgramTable::SpaceLocArs:
+      case IR::ProgramTable::SpaceModArs:
+         if(!DumpSpace && !stats) return false;
+         break;
+
+      case IR::ProgramTable::StrEnt:
+         if(!DumpStrEnt && !stats) return false;
+         break;
+      }
+
+      return !glyph || std::regex_search(name.data(), name.data() + name.size(), *glyph);
+   }
+
+   //
+   // Filter::filterSize
+   //
+   void Filter::filterSize(IR::ProgramTable table, Core::String name,
+      std::size_t size)
+   {
+      if(table == IR::ProgramTable::Function)
+         sizeFunction[name] += size;
+   }
+}
+
+// EOF
+
@@ -0,0 +1,56 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// IR entry selection.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__IRDump__Filter_H__
+#define GDCC__IRDump__Filter_H__
+
+#include "../IRDump/Types.hpp"
+
+#include "../IR/Program.hpp"
+
+#include <memory>
+#include <regex>
+#include <unordered_map>
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+namespace GDCC::IRDump
+{
+   //
+   // Filter
+   //
+   // Selects the entries to read for dumping, so that the rest are neither
+   // kept nor, for indexed IR, decoded. Also records the encoded size of the
+   // entries read.
+   //
+   class Filter : public IR::ProgramFilter
+   {
+   public:
+      Filter();
+
+      virtual bool filter(IR::ProgramTable table, Core::String name);
+
+      virtual void filterSize(IR::ProgramTable table, Core::String name,
+         std::size_t size);
+
+      std::unordered_map<Core::String, std::size_t> sizeFunction;
+
+   private:
+      std::unique_ptr<std::regex> glyph;
+   };
+}
+
+#endif//GDCC__IRDump__Filter_H__
+
@@ -42,7 +42,8 @@ namespace GDCC::IRDump
 
    void PutObject(std::ostream &out, IR::Object const &obj);
 
-   void PutProgram(std::ostream &out, IR::Program const &prog);
+   void PutProgram(std::ostream &out, IR::Program const &prog,
+      Filter const &filter);
 
    void PutSpace(std::ostream &out, IR::Space const &sp);
 
@@ -79,6 +80,7 @@ namespace GDCC::IRDump
    extern Option::Bool DumpOrigin;
    extern Option::Bool DumpSpace;
    extern Option::Bool DumpStatistics;
+   extern Option::Bool DumpStats;
    extern Option::Bool DumpStrEnt;
 }
 
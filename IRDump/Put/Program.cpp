@@ -12,12 +12,18 @@
 
 #include "IRDump/Put.hpp"
 
+#include "IRDump/Filter.hpp"
+
 #include "Core/Option.hpp"
 
 #include "IR/Program.hpp"
 
 #include "Option/Bool.hpp"
 
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
 
 //----------------------------------------------------------------------------|
 // Options                                                                    |
@@ -129,6 +135,22 @@ namespace GDCC::IRDump
       false
    };
 
+   //
+   // --stats
+   //
+   Option::Bool DumpStats
+   {
+      &Core::GetOptionList(), Option::Base::Info()
+         .setName("stats")
+         .setGroup("output")
+         .setDescS("Dump per-function statistics.")
+         .setDescL("Dump per-function statistics: encoded IR size, number "
+            "of statements, and local registers used. Functions are sorted "
+            "by encoded size, largest first."),
+
+      false
+   };
+
    //
    // --dump-strent
    //
@@ -161,6 +183,55 @@ namespace GDCC::IRDump
       out << ";; " << str; for(int i = sp; i--;) out << ' '; out << "|\n";
       out << ";;\n";
    }
+
+   //
+   // PutStats
+   //
+   static void PutStats(std::ostream &out, IR::Program const &prog,
+      Filter const &filter)
+   {
+      struct Stats
+      {
+         Core::String name;
+         std::size_t  bytes;
+         std::size_t  stmnts;
+         Core::FastU  regs;
+      };
+
+      std::vector<Stats> stats;
+      std::size_t        bytes = 0, stmnts = 0;
+
+      for(auto const &fn : prog.rangeFunction())
+      {
+         auto itr = filter.sizeFunction.find(fn.glyph);
+
+         stats.push_back({fn.glyph,
+            itr == filter.sizeFunction.end() ? 0 : itr->second,
+            fn.block.size(), fn.getLocalReg()});
+
+         bytes  += stats.back().bytes;
+         stmnts += stats.back().stmnts;
+      }
+
+      std::sort(stats.begin(), stats.end(), [](Stats const &l, Stats const &r)
+         {return l.bytes != r.bytes ? l.bytes > r.bytes : l.name < r.name;});
+
+      if(DumpHeaders) PutHeader(out, "Function Statistics");
+
+      out << ";;      bytes   stmnts   regs  function\n";
+
+      for(auto const &s : stats)
+      {
+         out << ";; " << std::setw(10) << s.bytes << ' '
+            << std::setw(8) << s.stmnts << ' '
+            << std::setw(6) << s.regs << "  ";
+         PutString(out, s.name);
+         out << '\n';
+      }
+
+      out << ";; " << std::setw(10) << bytes << ' '
+         << std::setw(8) << stmnts << "         total\n";
+   }
 }
 
 
@@ -173,7 +244,8 @@ namespace GDCC::IRDump
    //
    // PutProgram
    //
-   void PutProgram(std::ostream &out, IR::Program const &prog)
+   void PutProgram(std::ostream &out, IR::Program const &prog,
+      Filter const &filter)
    {
       // File header.
       if(DumpHeaders)
@@ -208,7 +280,11 @@ namespace GDCC::IRDump
          }
       }
 
-      // Functions
+      // Function statistics.
+      if(DumpStats)
+         PutStats(out, prog, filter);
+
+      // DJumps
       if(DumpDJump)
       {
          if(DumpHeaders) PutHeader(out, "DJumps");
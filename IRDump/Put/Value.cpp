@@ -44,13 +44,8 @@ namespace GDCC::IRDump
       PutType_Array(out << "Value ", val.vtype);
 
       out << " (";
-      if(!val.value.empty())
-      {
-         auto itr = val.value.begin(), end = val.value.end();
-         PutValue(out, *itr++);
-         while(itr != end)
-            PutValue(out << ' ', *itr++);
-      }
+      for(std::size_t i = 0, e = val.size(); i != e; ++i)
+         PutValue(i ? out << ' ' : out, val.getElem(i));
       out << ')';
    }
 
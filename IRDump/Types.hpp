@@ -22,6 +22,7 @@
 
 namespace GDCC::IRDump
 {
+   class Filter;
 }
 
 #endif//GDCC__IRDump__Types_H__
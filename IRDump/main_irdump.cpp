@@ -10,10 +10,12 @@
 //
 //-----------------------------------------------------------------------------
 
+#include "IRDump/Filter.hpp"
 #include "IRDump/Put.hpp"
 
 #include "Core/File.hpp"
 #include "Core/Option.hpp"
+#include "Core/StringBuf.hpp"
 
 #include "IR/IArchive.hpp"
 #include "IR/Program.hpp"
@@ -26,36 +28,53 @@
 // Static Functions                                                           |
 //
 
-static void ProcessFile(char const *inName, GDCC::IR::Program &prog);
+static void ProcessFile(char const *inName, GDCC::IR::Program &prog,
+   GDCC::IRDump::Filter &filter);
 
 //
 // MakeIRDump
 //
 static void MakeIRDump()
 {
-   GDCC::IR::Program prog;
+   GDCC::IR::Program     prog;
+   GDCC::IRDump::Filter filter;
 
    // Process inputs.
    for(auto const &arg : GDCC::Core::GetOptionArgs())
-      ProcessFile(arg, prog);
+      ProcessFile(arg, prog, filter);
 
    auto outName = GDCC::Core::GetOptionOutput();
    if(!outName) outName = "-";
 
    auto buf = GDCC::Core::FileOpenStream(outName, std::ios_base::out);
    std::ostream out{buf.get()};
-   GDCC::IRDump::PutProgram(out, prog);
+   GDCC::IRDump::PutProgram(out, prog, filter);
 }
 
 //
 // ProcessFile
 //
-static void ProcessFile(char const *inName, GDCC::IR::Program &prog)
+// Files are mapped rather than streamed, so that entries excluded by the
+// filter can be skipped over using the archive's index.
+//
+static void ProcessFile(char const *inName, GDCC::IR::Program &prog,
+   GDCC::IRDump::Filter &filter)
 {
-   auto buf = GDCC::Core::FileOpenStream(inName, std::ios_base::in | std::ios_base::binary);
-   std::istream in{buf.get()};
-   GDCC::IR::IArchive arc{in};
-   arc >> prog;
+   // Standard input is read as a stream, since blocks read it as text.
+   if(inName[0] == '-' && inName[1] == '\0')
+   {
+      auto buf = GDCC::Core::FileOpenStream(inName, std::ios_base::in | std::ios_base::binary);
+      std::istream in{buf.get()};
+      GDCC::IR::IArchive arc{in};
+      GDCC::IR::GetProgram(arc, prog, &filter);
+      return;
+   }
+
+   auto                  buf = GDCC::Core::FileOpenBlock(inName);
+   GDCC::Core::StringBuf sbuf{buf->data(), buf->size()};
+   std::istream          in{&sbuf};
+   GDCC::IR::IArchive    arc{in};
+   GDCC::IR::GetProgram(arc, prog, &filter);
 }
 
 
@@ -106,9 +106,12 @@ namespace GDCC::LD
 
          else if(len == 3 && !std::memcmp(str, "chk", 3)) info->chk(prog);
          else if(len == 3 && !std::memcmp(str, "gen", 3)) info->gen(prog);
+         else if(len == 3 && !std::memcmp(str, "inl", 3)) info->inl(prog);
          else if(len == 3 && !std::memcmp(str, "opt", 3)) info->opt(prog);
          else if(len == 3 && !std::memcmp(str, "pre", 3)) info->pre(prog);
 
+         else if(len == 4 && !std::memcmp(str, "flow", 4)) info->flow(prog);
+
          else
             Core::ErrorExpect({}, "IR processing step", {str, len});
       };
@@ -198,6 +201,8 @@ namespace GDCC::LD
       {
          info->chk(prog);
          info->pre(prog);
+         info->inl(prog);
+         info->flow(prog);
          info->opt(prog);
          info->tr(prog);
          info->opt(prog);
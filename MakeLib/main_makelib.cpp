@@ -17,35 +17,16 @@
 #include "Core/Option.hpp"
 #include "Core/Path.hpp"
 
+#include "IR/Cache.hpp"
 #include "IR/Program.hpp"
 
 #include "LD/Linker.hpp"
 
-#include "Option/Bool.hpp"
-
 #include "Target/Info.hpp"
 
 #include <iostream>
 
 
-//----------------------------------------------------------------------------|
-// Options                                                                    |
-//
-
-//
-// --progress
-//
-static GDCC::Option::Bool Progress
-{
-   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
-      .setName("progress")
-      .setGroup("output")
-      .setDescS("Writes progress information to stderr."),
-
-   false
-};
-
-
 //----------------------------------------------------------------------------|
 // Static Functions                                                           |
 //
@@ -57,10 +38,10 @@ static void MakeLib_AS(GDCC::IR::Program &prog, std::string path, char const *na
 {
    GDCC::Core::PathAppend(path, name);
 
-   if(Progress)
+   if(GDCC::Core::GetOptions().optProgress)
       std::cerr << "gdcc-as " << path << std::endl;
 
-   GDCC::AS::ParseFile(path.data(), prog);
+   GDCC::IR::CacheParseFile("as", path.data(), prog, GDCC::AS::ParseFile);
 }
 
 //
@@ -70,10 +51,10 @@ static void MakeLib_CC(GDCC::IR::Program &prog, std::string path, char const *na
 {
    GDCC::Core::PathAppend(path, name);
 
-   if(Progress)
+   if(GDCC::Core::GetOptions().optProgress)
       std::cerr << "gdcc-cc " << path << std::endl;
 
-   GDCC::CC::ParseFile(path.data(), prog);
+   GDCC::IR::CacheParseFile("cc", path.data(), prog, GDCC::CC::ParseFile);
 }
 
 //
@@ -156,6 +137,9 @@ static void MakeLib()
       }
    }
 
+   if(GDCC::Core::GetOptions().optProgress)
+      GDCC::IR::CachePutStats(std::cerr);
+
    // Write output.
    GDCC::LD::Link(prog, GDCC::Core::GetOptionOutput());
 }
@@ -186,7 +170,9 @@ int main(int argc, char *argv[])
       "\n"
       "Output defaults to last loose argument.";
 
+   opts.optCacheDir.insert(&opts.list);
    opts.optLibPath.insert(&opts.list);
+   opts.optProgress.insert(&opts.list);
 
    try
    {
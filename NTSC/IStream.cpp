@@ -0,0 +1,44 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// NTSC input stream.
+//
+//-----------------------------------------------------------------------------
+
+#include "NTSC/IStream.hpp"
+
+#include "Core/StringBuf.hpp"
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::NTSC
+{
+   //
+   // IStream constructor
+   //
+   IStream::IStream(std::streambuf &buf, Core::String file) :
+      std::istream{&obuf},
+      obuf{buf, {file, 1, 1}},
+      orig{&obuf}
+   {
+      auto str = dynamic_cast<Core::StringBuf *>(&buf);
+      if(!str)
+         return;
+
+      sbuf.reset(new Core::SourceBuf{str->data(), str->size(), {file, 1, 1},
+         Core::SourceBuf::Mode::Raw});
+      orig = sbuf.get();
+      rdbuf(sbuf.get());
+   }
+}
+
+// EOF
+
@@ -16,8 +16,10 @@
 #include "../NTSC/Types.hpp"
 
 #include "../Core/OriginBuf.hpp"
+#include "../Core/SourceBuf.hpp"
 
 #include <istream>
+#include <memory>
 
 
 //----------------------------------------------------------------------------|
@@ -29,18 +31,24 @@ namespace GDCC::NTSC
    //
    // IStream
    //
+   // If buf is a Core::StringBuf, its contents are read directly by a
+   // Core::SourceBuf.
+   //
    class IStream : public std::istream
    {
    public:
-      explicit IStream(std::streambuf &buf, Core::String file) :
-         std::istream{&obuf}, obuf{buf, {file, 1, 1}} {}
+      IStream(std::streambuf &buf, Core::String file);
 
-      Core::OriginSource &getOriginSource() {return obuf;}
+      Core::OriginSource &getOriginSource() {return *orig;}
 
    protected:
       using OBuf = Core::OriginBuf<8>;
 
       OBuf obuf;
+
+      std::unique_ptr<Core::SourceBuf> sbuf;
+
+      Core::OriginSource *orig;
    };
 }
 
@@ -0,0 +1,297 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Direct NTS source output.
+//
+// Mirrors TSource, ConcatTBuf, and PutToken. Errors are not diagnosed here,
+// but left for the token stream to report with the usual messages.
+//
+//-----------------------------------------------------------------------------
+
+#include "NTSC/PutSource.hpp"
+
+#include "Core/Parse.hpp"
+
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+
+
+//----------------------------------------------------------------------------|
+// Static Functions                                                           |
+//
+
+namespace GDCC::NTSC
+{
+   //
+   // IsIdentiChar
+   //
+   static bool IsIdentiChar(unsigned char c)
+   {
+      return std::isalnum(c) || c == '_' || c >= 0x80;
+   }
+
+   //
+   // IsNumberChar
+   //
+   static bool IsNumberChar(unsigned char c, char prev)
+   {
+      if(std::isalnum(c)) return true;
+      if(c == '.' || c == '_') return true;
+
+      if(c == '+' || c == '-')
+         return prev == 'E' || prev == 'e' || prev == 'P' || prev == 'p';
+
+      return false;
+   }
+
+   //
+   // PutNumber
+   //
+   // Only handles numbers that fit in 64 bits.
+   //
+   static bool PutNumber(std::string &out, char const *&itr, char const *end)
+   {
+      char const *first = itr;
+
+      for(char prev = '\0'; itr != end && IsNumberChar(*itr, prev);)
+         prev = *itr++;
+
+      // Determine base, as ParseNumberBaseC.
+      char const *s = first;
+      unsigned    base;
+
+      if(s[0] != '0')
+         base = 10;
+      else if(s + 1 != itr && (s[1] == 'B' || s[1] == 'b'))
+         base = 2, s += 2;
+      else if(s + 1 != itr && (s[1] == 'X' || s[1] == 'x'))
+         base = 16, s += 2;
+      else
+      {
+         base = 8, s += 1;
+         for(auto dot = first; dot != itr && *dot != '_'; ++dot)
+            if(*dot == '.') {base = 10, s = first; break;}
+      }
+
+      std::uint_least64_t val = 0;
+      for(; s != itr; ++s)
+      {
+         if(!Core::IsDigit(*s, base))
+            return false;
+
+         unsigned digit = Core::ToDigit(*s);
+         if(val > (UINT64_MAX - digit) / base)
+            return false;
+
+         val = val * base + digit;
+      }
+
+      char  buf[17];
+      char *bufEnd = buf + sizeof(buf), *bufItr = bufEnd;
+      do *--bufItr = "0123456789ABCDEF"[val & 0xF]; while(val >>= 4);
+
+      out += '0';
+      out.append(bufItr, bufEnd);
+      out += '\0';
+
+      return true;
+   }
+
+   //
+   // PutString
+   //
+   // Appends the contents of a string or character literal, as parsed by
+   // ParseStringC, without a terminator.
+   //
+   static bool PutString(std::string &out, char const *&itr, char const *end)
+   {
+      char        term = *itr;
+      char const *s    = itr + 1;
+
+      // Find the end, as ReadStringC.
+      for(;; ++s)
+      {
+         if(s == end || *s == '\n')
+            return false;
+
+         if(*s == term)
+            break;
+
+         if(*s == '\\' && (++s == end || *s == '\n'))
+            return false;
+      }
+
+      char const *close = s;
+
+      for(s = itr + 1; s != close;)
+      {
+         char c = *s++;
+
+         if(c != '\\')
+         {
+            out += c;
+            continue;
+         }
+
+         char32_t i;
+
+         switch(c = *s++)
+         {
+         case '\'': out += '\''; continue;
+         case '\"': out += '\"'; continue;
+         case '\?': out += '\?'; continue;
+         case '\\': out += '\\'; continue;
+
+         case 'C': out += '\x1C'; continue;
+
+         case 'a': out += '\a'; continue;
+         case 'b': out += '\b'; continue;
+         case 'f': out += '\f'; continue;
+         case 'n': out += '\n'; continue;
+         case 'r': out += '\r'; continue;
+         case 't': out += '\t'; continue;
+         case 'v': out += '\v'; continue;
+
+         case 'x':
+            for(i = 0; s != close && std::isxdigit(static_cast<unsigned char>(*s)); ++s)
+               i = i * 16 + Core::ToDigit(*s);
+            break;
+
+         case '0': case '1': case '2': case '3':
+         case '4': case '5': case '6': case '7':
+            i = c - '0';
+            for(int n = 2; n-- && s != close && *s >= '0' && *s <= '7'; ++s)
+               i = i * 8 + (*s - '0');
+            break;
+
+         default:
+            return false;
+         }
+
+         // Write as UTF-8, as ParseEscapeC.
+         if(i <= 0x7F) {out += static_cast<char>(i); continue;}
+
+         int n;
+         if(i <= 0x7FF)           n = 1, out += static_cast<char>(0xC0 | ((i >>  6) & 0x1F));
+         else if(i <= 0xFFFF)     n = 2, out += static_cast<char>(0xE0 | ((i >> 12) & 0x0F));
+         else if(i <= 0x1FFFFF)   n = 3, out += static_cast<char>(0xF0 | ((i >> 18) & 0x07));
+         else if(i <= 0x3FFFFFF)  n = 4, out += static_cast<char>(0xF8 | ((i >> 24) & 0x03));
+         else if(i <= 0x7FFFFFFF) n = 5, out += static_cast<char>(0xFC | ((i >> 30) & 0x01));
+         else                     n = 6, out += '\xFE';
+
+         while(n--)
+            out += static_cast<char>(0x80 | ((i >> (n < 5 ? n * 6 : 30)) & 0x3F));
+      }
+
+      itr = close + 1;
+      return true;
+   }
+}
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::NTSC
+{
+   //
+   // PutSource
+   //
+   bool PutSource(std::string &out, char const *data, std::size_t size)
+   {
+      char const *itr  = data, *end = data + size;
+      std::size_t base = out.size();
+
+      // The stream reads a 0xFF byte as end of file.
+      if(std::memchr(data, '\xFF', size))
+         return false;
+
+      // Quote of a string literal that has not been terminated yet, so that
+      // an adjacent literal of the same kind can be appended to it.
+      char quote = '\0';
+
+      for(;;)
+      {
+         // Skip whitespace and comments.
+         while(itr != end)
+         {
+            if(std::isspace(static_cast<unsigned char>(*itr)))
+               ++itr;
+            else if(*itr == '#')
+               while(itr != end && *itr != '\n') ++itr;
+            else
+               break;
+         }
+
+         if(quote && (itr == end || *itr != quote))
+            out += '\0', quote = '\0';
+
+         if(itr == end)
+            return true;
+
+         char c = *itr;
+
+         switch(c)
+         {
+         case ',': case '=': case ';':
+         case '{': case '}': case '(': case ')':
+            out += c;
+            out += '\0';
+            ++itr;
+            continue;
+
+         case '.':
+            // Is this actually a number?
+            if(itr + 1 != end && std::isdigit(static_cast<unsigned char>(itr[1])))
+               break;
+
+            out += '.';
+            out += '\0';
+            ++itr;
+            continue;
+
+         case '"': case '\'':
+            if(!PutString(out, itr, end))
+               return out.resize(base), false;
+
+            quote = c;
+            continue;
+         }
+
+         // Number token.
+         if(std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+         {
+            if(!PutNumber(out, itr, end))
+               return out.resize(base), false;
+
+            continue;
+         }
+
+         // Identifier token.
+         if(IsIdentiChar(c))
+         {
+            char const *first = itr;
+            while(++itr != end && IsIdentiChar(*itr)) {}
+
+            out.append(first, itr);
+            out += '\0';
+            continue;
+         }
+
+         // Non-token character.
+         out += c;
+         out += '\0';
+         ++itr;
+      }
+   }
+}
+
+// EOF
+
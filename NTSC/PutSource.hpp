@@ -0,0 +1,37 @@
+//-----------------------------------------------------------------------------
+//
+// Copyright (C) 2026 David Hill
+//
+// See COPYING for license information.
+//
+//-----------------------------------------------------------------------------
+//
+// Direct NTS source output.
+//
+//-----------------------------------------------------------------------------
+
+#ifndef GDCC__NTSC__PutSource_H__
+#define GDCC__NTSC__PutSource_H__
+
+#include "../NTSC/Types.hpp"
+
+#include <string>
+
+
+//----------------------------------------------------------------------------|
+// Extern Functions                                                           |
+//
+
+namespace GDCC::NTSC
+{
+   // Converts source text to NTS output, appending to out. The result is the
+   // same as writing every token from TStream with PutToken, but the source
+   // is read in place and no strings are interned, so it can be called from
+   // multiple threads. Returns false if the source contains anything not
+   // handled here, including anything that would be an error, in which case
+   // out is left unchanged and TStream must be used instead.
+   bool PutSource(std::string &out, char const *data, std::size_t size);
+}
+
+#endif//GDCC__NTSC__PutSource_H__
+
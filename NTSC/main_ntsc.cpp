@@ -11,6 +11,7 @@
 //-----------------------------------------------------------------------------
 
 #include "NTSC/IStream.hpp"
+#include "NTSC/PutSource.hpp"
 #include "NTSC/PutToken.hpp"
 #include "NTSC/TSource.hpp"
 #include "NTSC/TStream.hpp"
@@ -20,7 +21,12 @@
 #include "Core/Option.hpp"
 #include "Core/Token.hpp"
 
+#include "Option/Int.hpp"
+
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 
 //----------------------------------------------------------------------------|
@@ -67,11 +73,43 @@ static GDCC::Option::CStr NTSVersion
 };
 
 
+//
+// -j, --jobs
+//
+static GDCC::Option::Int<std::size_t> NTSJobs
+{
+   &GDCC::Core::GetOptionList(), GDCC::Option::Base::Info()
+      .setName("jobs").setName('j')
+      .setGroup("input")
+      .setDescS("Sets the number of threads reading inputs. Default: processors"),
+
+   0
+};
+
+
+//----------------------------------------------------------------------------|
+// Types                                                                      |
+//
+
+//
+// SourceJob
+//
+// The output of an input converted by PutSource.
+//
+class SourceJob
+{
+public:
+   std::string out;
+   bool        done = false;
+};
+
+
 //----------------------------------------------------------------------------|
 // Static Functions                                                           |
 //
 
 static void ProcessFile(std::ostream &out, char const *inName);
+static void PutSourceJobs(std::vector<SourceJob> &jobs);
 
 //
 // MakeDefs
@@ -99,8 +137,22 @@ static void MakeDefs()
    out << '\0';
 
    // Process inputs.
-   for(auto const &arg : GDCC::Core::GetOptionArgs())
-      ProcessFile(out, arg);
+   auto const &args = GDCC::Core::GetOptionArgs();
+
+   std::vector<SourceJob> jobs(args.size());
+   PutSourceJobs(jobs);
+
+   // Inputs that could not be converted directly are handled in order, so
+   // that any error is reported for the first such input.
+   for(std::size_t i = 0, e = jobs.size(); i != e; ++i)
+   {
+      if(jobs[i].done)
+         out.write(jobs[i].out.data(), jobs[i].out.size());
+      else
+         ProcessFile(out, args[i]);
+
+      jobs[i].out = std::string();
+   }
 }
 
 //
@@ -108,7 +160,8 @@ static void MakeDefs()
 //
 static void ProcessFile(std::ostream &out, char const *inName)
 {
-   auto buf = GDCC::Core::FileOpenStream(inName, std::ios_base::in);
+   auto buf = GDCC::Core::FileOpenSource(inName);
+
    GDCC::NTSC::IStream istr{*buf, inName};
    GDCC::NTSC::TSource tsrc{istr, istr.getOriginSource()};
    GDCC::NTSC::TStream tstr{tsrc};
@@ -116,6 +169,43 @@ static void ProcessFile(std::ostream &out, char const *inName)
       GDCC::NTSC::PutToken(out, tok);
 }
 
+//
+// PutSourceJobs
+//
+// Converts inputs in place without interning, split between threads.
+//
+static void PutSourceJobs(std::vector<SourceJob> &jobs)
+{
+   auto const &args = GDCC::Core::GetOptionArgs();
+
+   std::atomic<std::size_t> next{0};
+
+   auto work = [&]()
+   {
+      for(std::size_t i; (i = next++) < jobs.size();)
+      {
+         // Standard input is left to ProcessFile.
+         if(args[i][0] == '-' && args[i][1] == '\0')
+            continue;
+
+         if(auto block = GDCC::Core::FileTryBlock(args[i]))
+            jobs[i].done = GDCC::NTSC::PutSource(jobs[i].out, block->data(), block->size());
+      }
+   };
+
+   std::size_t workers = NTSJobs ? NTSJobs : std::thread::hardware_concurrency();
+   if(workers > jobs.size()) workers = jobs.size();
+
+   std::vector<std::thread> threads;
+   for(std::size_t i = 1; i < workers; ++i)
+      threads.emplace_back(work);
+
+   work();
+
+   for(auto &thread : threads)
+      thread.join();
+}
+
 
 //----------------------------------------------------------------------------|
 // Extern Functions                                                           |
@@ -17,6 +17,8 @@
 
 #include "../Option/Exception.hpp"
 
+#include <limits>
+
 
 //----------------------------------------------------------------------------|
 // Types                                                                      |
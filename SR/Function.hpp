@@ -21,7 +21,7 @@
 #include "../Core/NumberAlloc.hpp"
 #include "../Core/StringGen.hpp"
 
-#include <unordered_map>
+#include <map>
 
 
 //----------------------------------------------------------------------------|
@@ -39,7 +39,7 @@ namespace GDCC::SR
 
    protected:
       using IRExpCPtr     = Core::CounterPtr<IR::Exp   const>;
-      using LocalArr      = std::unordered_map<Core::FastU, Core::FastU>;
+      using LocalArr      = std::map<Core::FastU, Core::FastU>;
       using ScriptType    = Core::Array<Core::String>;
       using StatementCPtr = Core::CounterPtr<Statement const>;
       using TypeCPtr      = Core::CounterPtr<Type      const>;
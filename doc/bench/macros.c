@@ -0,0 +1,52 @@
+//-----------------------------------------------------------------------------
+//
+// Macro expansion benchmark.
+//
+// Run as: gdcc-cpp doc/bench/macros.c -o /dev/null
+//
+// Expands a few thousand nested function-like macro invocations, using the
+// argument substitution, #, ##, and __VA_ARGS__ forms that the library
+// headers rely on.
+//
+//-----------------------------------------------------------------------------
+
+#include <stdint.h>
+
+#define CAT(a, b) CAT_(a, b)
+#define CAT_(a, b) a ## b
+#define STR(x) STR_(x)
+#define STR_(x) #x
+
+#define FIRST(...) FIRST_(__VA_ARGS__, )
+#define FIRST_(a, ...) a
+#define REST(a, ...) __VA_ARGS__
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#define CLAMP(x, lo, hi) MIN(MAX(x, lo), hi)
+#define SQR(x) ((x) * (x))
+
+#define VEC(n) CAT(vec_, n)
+#define DOT(a, b) (SQR(a.x) + SQR(b.y) + (a.z) * (b.z))
+
+#define DECL(n) \
+   static int32_t VEC(n)(int32_t x, int32_t lo, int32_t hi) \
+   { \
+      x = CLAMP(x + INT32_C(n), MIN(lo, FIRST(hi, lo)), MAX(REST(lo, hi), lo)); \
+      return DOT(VEC(n##_a), VEC(n##_b)) + x; \
+   } \
+   static char const CAT(name_, n)[] = STR(VEC(n)) " " #n;
+
+#define R4(m, n)    m(n##0)     m(n##1)     m(n##2)     m(n##3)
+#define R16(m, n)   R4(m, n##0) R4(m, n##1) R4(m, n##2) R4(m, n##3)
+#define R64(m, n)   R16(m, n##0) R16(m, n##1) R16(m, n##2) R16(m, n##3)
+#define R256(m, n)  R64(m, n##0) R64(m, n##1) R64(m, n##2) R64(m, n##3)
+#define R1024(m, n) R256(m, n##0) R256(m, n##1) R256(m, n##2) R256(m, n##3)
+
+R1024(DECL, 1)
+R1024(DECL, 2)
+R1024(DECL, 3)
+R1024(DECL, 4)
+
+// EOF
+